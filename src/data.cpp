@@ -32,23 +32,51 @@ BOOST_CONCEPT_ASSERT((WireDecodable<Data>));
 static_assert(std::is_base_of<tlv::Error, Data::Error>::value,
               "Data::Error must inherit from tlv::Error");
 
+Data::Core::Core()
+  : content(tlv::Content) // empty content
+  , unsolicited(false)
+  , pendingDecode(0)
+{
+}
+
 Data::Data()
-  : m_content(tlv::Content) // empty content
-  , m_unsolicited(false)
+  : m_core(make_shared<Core>())
 {
 }
 
 Data::Data(const Name& name)
-  : m_name(name)
-  , m_unsolicited(false)
+  : m_core(make_shared<Core>())
 {
+  m_core->name = name;
 }
 
 Data::Data(const Block& wire)
+  : m_core(make_shared<Core>())
 {
   wireDecode(wire);
 }
 
+Data::Data(const Data& other)
+  : TagHost(other)
+  , enable_shared_from_this<Data>(other)
+  , m_core(other.shareCore())
+  , m_fullName(other.m_fullName)
+  , m_localControlHeader(other.m_localControlHeader)
+{
+}
+
+Data&
+Data::operator=(const Data& other)
+{
+  if (this != &other) {
+    TagHost::operator=(other);
+    m_core = other.shareCore();
+    m_fullName = other.m_fullName;
+    m_localControlHeader = other.m_localControlHeader;
+  }
+  return *this;
+}
+
 template<encoding::Tag TAG>
 size_t
 Data::wireEncode(EncodingImpl<TAG>& encoder, bool unsignedPortion/* = false*/) const
@@ -66,7 +94,8 @@ Data::wireEncode(EncodingImpl<TAG>& encoder, bool unsignedPortion/* = false*/) c
 
   // (reverse encoding)
 
-  if (!unsignedPortion && !m_signature)
+  const Signature& signature = getSignature();
+  if (!unsignedPortion && !signature)
     {
       BOOST_THROW_EXCEPTION(Error("Requested wire format, but data packet has not been signed yet"));
     }
@@ -74,11 +103,11 @@ Data::wireEncode(EncodingImpl<TAG>& encoder, bool unsignedPortion/* = false*/) c
   if (!unsignedPortion)
     {
       // SignatureValue
-      totalLength += encoder.prependBlock(m_signature.getValue());
+      totalLength += encoder.prependBlock(signature.getValue());
     }
 
   // SignatureInfo
-  totalLength += encoder.prependBlock(m_signature.getInfo());
+  totalLength += encoder.prependBlock(signature.getInfo());
 
   /* PDRM Change */
   if (getUnsolicited()) {
@@ -123,14 +152,15 @@ Data::wireEncode(EncodingBuffer& encoder, const Block& signatureValue) const
   encoder.prependVarNumber(tlv::Data);
 
   const_cast<Data*>(this)->wireDecode(encoder.block());
-  return m_wire;
+  return m_core->wire;
 }
 
 const Block&
 Data::wireEncode() const
 {
-  if (m_wire.hasWire())
-    return m_wire;
+  if (m_core->wire.hasWire())
+    return m_core->wire;
+  BOOST_ASSERT(m_core.unique());
 
   EncodingEstimator estimator;
   size_t estimatedSize = wireEncode(estimator);
@@ -138,16 +168,29 @@ Data::wireEncode() const
   EncodingBuffer buffer(estimatedSize, 0);
   wireEncode(buffer);
 
-  const_cast<Data*>(this)->wireDecode(buffer.block());
-  return m_wire;
+  // a core without wire encoding is never shared, so this updates only this Data packet
+  decodeCore(buffer.block());
+  // all fields were just encoded from their decoded form, nothing to decode lazily
+  m_core->pendingDecode = 0;
+  return m_core->wire;
 }
 
 void
 Data::wireDecode(const Block& wire)
+{
+  if (!m_core.unique()) {
+    // other copies keep their current value
+    m_core = make_shared<Core>();
+  }
+  decodeCore(wire);
+}
+
+void
+Data::decodeCore(const Block& wire) const
 {
   m_fullName.clear();
-  m_wire = wire;
-  m_wire.parse();
+  m_core->wire = wire;
+  m_core->wire.parse();
 
   // Data ::= DATA-TLV TLV-LENGTH
   //            Name
@@ -159,39 +202,57 @@ Data::wireDecode(const Block& wire)
   //            Signature
 
   // Name
-  m_name.wireDecode(m_wire.get(tlv::Name));
+  m_core->name.wireDecode(m_core->wire.get(tlv::Name));
 
-  // MetaInfo
-  m_metaInfo.wireDecode(m_wire.get(tlv::MetaInfo));
+  // MetaInfo and Signature are decoded on first access, but must be present and well-formed
+  MetaInfo::validate(m_core->wire.get(tlv::MetaInfo));
+  SignatureInfo::validate(m_core->wire.get(tlv::SignatureInfo));
+  m_core->pendingDecode = PENDING_META_INFO | PENDING_SIGNATURE;
 
   // Content
-  m_content = m_wire.get(tlv::Content);
+  m_core->content = m_core->wire.get(tlv::Content);
 
   /* PDRM Change */
-  Block::element_const_iterator val = m_wire.find(tlv::PDRMUnsolicited);
-  if (val != m_wire.elements_end()) {
-    m_unsolicited = true;
-  }
+  m_core->unsolicited = m_core->wire.find(tlv::PDRMUnsolicited) != m_core->wire.elements_end();
   /* PDRM Change */
+}
+
+void
+Data::decodePendingMetaInfo() const
+{
+  BOOST_ASSERT(m_core->wire.hasWire());
+  BOOST_ASSERT(m_core.unique());
+
+  m_core->metaInfo.wireDecode(m_core->wire.get(tlv::MetaInfo));
+
+  m_core->pendingDecode &= ~PENDING_META_INFO;
+}
+
+void
+Data::decodePendingSignature() const
+{
+  BOOST_ASSERT(m_core->wire.hasWire());
+  BOOST_ASSERT(m_core.unique());
 
   ///////////////
   // Signature //
   ///////////////
 
+  // SignatureValue
+  Block::element_const_iterator val = m_core->wire.find(tlv::SignatureValue);
+
   // SignatureInfo
-  m_signature.setInfo(m_wire.get(tlv::SignatureInfo));
+  m_core->signature = Signature(m_core->wire.get(tlv::SignatureInfo),
+                                val != m_core->wire.elements_end() ? *val : Block());
 
-  // SignatureValue
-  val = m_wire.find(tlv::SignatureValue);
-  if (val != m_wire.elements_end())
-    m_signature.setValue(*val);
+  m_core->pendingDecode &= ~PENDING_SIGNATURE;
 }
 
 Data&
 Data::setName(const Name& name)
 {
   onChanged();
-  m_name = name;
+  m_core->name = name;
 
   return *this;
 }
@@ -200,12 +261,12 @@ const Name&
 Data::getFullName() const
 {
   if (m_fullName.empty()) {
-    if (!m_wire.hasWire()) {
+    if (!m_core->wire.hasWire()) {
       BOOST_THROW_EXCEPTION(Error("Full name requested, but Data packet does not have wire format "
                                   "(e.g., not signed)"));
     }
-    m_fullName = m_name;
-    m_fullName.appendImplicitSha256Digest(crypto::sha256(m_wire.wire(), m_wire.size()));
+    m_fullName = m_core->name;
+    m_fullName.appendImplicitSha256Digest(crypto::sha256(m_core->wire.wire(), m_core->wire.size()));
   }
 
   return m_fullName;
@@ -215,7 +276,7 @@ Data&
 Data::setMetaInfo(const MetaInfo& metaInfo)
 {
   onChanged();
-  m_metaInfo = metaInfo;
+  m_core->metaInfo = metaInfo;
 
   return *this;
 }
@@ -224,7 +285,7 @@ Data&
 Data::setContentType(uint32_t type)
 {
   onChanged();
-  m_metaInfo.setType(type);
+  m_core->metaInfo.setType(type);
 
   return *this;
 }
@@ -233,7 +294,7 @@ Data&
 Data::setFreshnessPeriod(const time::milliseconds& freshnessPeriod)
 {
   onChanged();
-  m_metaInfo.setFreshnessPeriod(freshnessPeriod);
+  m_core->metaInfo.setFreshnessPeriod(freshnessPeriod);
 
   return *this;
 }
@@ -242,7 +303,7 @@ Data&
 Data::setFinalBlockId(const name::Component& finalBlockId)
 {
   onChanged();
-  m_metaInfo.setFinalBlockId(finalBlockId);
+  m_core->metaInfo.setFinalBlockId(finalBlockId);
 
   return *this;
 }
@@ -250,12 +311,12 @@ Data::setFinalBlockId(const name::Component& finalBlockId)
 const Block&
 Data::getContent() const
 {
-  if (m_content.empty())
-    m_content = makeEmptyBlock(tlv::Content);
+  if (m_core->content.empty())
+    m_core->content = makeEmptyBlock(tlv::Content);
 
-  if (!m_content.hasWire())
-    m_content.encode();
-  return m_content;
+  if (!m_core->content.hasWire())
+    m_core->content.encode();
+  return m_core->content;
 }
 
 Data&
@@ -263,7 +324,7 @@ Data::setContent(const uint8_t* content, size_t contentLength)
 {
   onChanged();
 
-  m_content = makeBinaryBlock(tlv::Content, content, contentLength);
+  m_core->content = makeBinaryBlock(tlv::Content, content, contentLength);
 
   return *this;
 }
@@ -273,7 +334,7 @@ Data::setContent(const ConstBufferPtr& contentValue)
 {
   onChanged();
 
-  m_content = Block(tlv::Content, contentValue); // not a real wire encoding yet
+  m_core->content = Block(tlv::Content, contentValue); // not a real wire encoding yet
 
   return *this;
 }
@@ -284,9 +345,9 @@ Data::setContent(const Block& content)
   onChanged();
 
   if (content.type() == tlv::Content)
-    m_content = content;
+    m_core->content = content;
   else {
-    m_content = Block(tlv::Content, content);
+    m_core->content = Block(tlv::Content, content);
   }
 
   return *this;
@@ -296,7 +357,7 @@ Data&
 Data::setSignature(const Signature& signature)
 {
   onChanged();
-  m_signature = signature;
+  m_core->signature = signature;
 
   return *this;
 }
@@ -305,7 +366,7 @@ Data&
 Data::setSignatureValue(const Block& value)
 {
   onChanged();
-  m_signature.setValue(value);
+  m_core->signature.setValue(value);
 
   return *this;
 }
@@ -334,12 +395,45 @@ Data::setCachingPolicy(nfd::LocalControlHeader::CachingPolicy cachingPolicy)
 Data&
 Data::setUnsolicited(const bool& unsolicited)
 {
-  m_unsolicited = unsolicited;
+  detach();
+  m_core->unsolicited = unsolicited;
 
   return *this;
 }
 /* PDRM Change */
 
+Data
+Data::clone() const
+{
+  Data copy(*this);
+  copy.m_core = make_shared<Core>(*m_core);
+  return copy;
+}
+
+void
+Data::detach()
+{
+  if (!m_core.unique()) {
+    m_core = make_shared<Core>(*m_core);
+  }
+}
+
+shared_ptr<Data::Core>
+Data::shareCore() const
+{
+  if (!m_core->wire.hasWire()) {
+    // wireEncode or getContent would write into the core later
+    return make_shared<Core>(*m_core);
+  }
+
+  // a core that is already shared has nothing pending
+  if (m_core->pendingDecode & PENDING_META_INFO)
+    decodePendingMetaInfo();
+  if (m_core->pendingDecode & PENDING_SIGNATURE)
+    decodePendingSignature();
+  return m_core;
+}
+
 void
 Data::onChanged()
 {
@@ -348,7 +442,15 @@ Data::onChanged()
   // !!!Note!!! Signature is not invalidated and it is responsibility of
   // the application to do proper re-signing if necessary
 
-  m_wire.reset();
+  detach();
+
+  // fields with deferred decoding must be decoded before their only source is discarded
+  if (m_core->pendingDecode & PENDING_META_INFO)
+    decodePendingMetaInfo();
+  if (m_core->pendingDecode & PENDING_SIGNATURE)
+    decodePendingSignature();
+
+  m_core->wire.reset();
   m_fullName.clear();
 }
 
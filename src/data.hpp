@@ -35,6 +35,10 @@
 namespace ndn {
 
 /** @brief represents a Data packet
+ *
+ * Copies of a Data packet share their decoded fields and wire encoding until one of them is
+ * modified.  The shared state is never written, so copies can be used on different threads
+ * as long as blocks obtained from them (e.g., getContent) are not parsed in place.
  */
 class Data : public TagHost, public enable_shared_from_this<Data>
 {
@@ -88,6 +92,33 @@ public:
   explicit
   Data(const Block& wire);
 
+  /**
+   * @brief Create a copy that shares the decoded fields and wire encoding of @p other
+   *
+   * Fields of @p other whose decoding has been deferred are decoded first, so that the
+   * shared state is complete.  A Data packet without wire encoding is copied field by field,
+   * because wireEncode would otherwise cache its encoding in the shared state.
+   */
+  Data(const Data& other);
+
+  Data(Data&& other) = default;
+
+  Data&
+  operator=(const Data& other);
+
+  Data&
+  operator=(Data&& other) = default;
+
+  /**
+   * @brief Create a copy that shares no state with this Data packet
+   *
+   * Unlike the copy constructor, the copy gets its own decoded fields and wire encoding;
+   * only the immutable bytes of the encoding are shared.  This keeps a Data packet handed to
+   * another thread from contending on the reference count of the shared state.
+   */
+  Data
+  clone() const;
+
   /**
    * @brief Fast encoding or block size estimation
    *
@@ -326,15 +357,82 @@ protected:
   onChanged();
 
 private:
-  Name m_name;
-  MetaInfo m_metaInfo;
-  mutable Block m_content;
-  Signature m_signature;
-  /* PDRM Change */
-  bool m_unsolicited;
-  /* PDRM Change */
+  struct Core;
+
+  /**
+   * @brief Make the core private to this Data packet, copying it if it is shared
+   */
+  void
+  detach();
+
+  /**
+   * @brief Get the core for a copy of this Data packet
+   *
+   * The core is returned itself once nothing is left for a const method to write into it:
+   * pending fields are decoded first.  If the wire encoding has yet to be cached, a private
+   * copy of the core is returned instead.
+   */
+  shared_ptr<Core>
+  shareCore() const;
+
+  /**
+   * @brief Decode @p wire into the core without detaching it
+   */
+  void
+  decodeCore(const Block& wire) const;
+
+  /**
+   * @brief Decode MetaInfo from the wire format recorded by wireDecode
+   */
+  void
+  decodePendingMetaInfo() const;
+
+  /**
+   * @brief Decode SignatureInfo and SignatureValue from the wire format recorded by wireDecode
+   */
+  void
+  decodePendingSignature() const;
+
+private:
+  /**
+   * @brief Fields that are decoded on first access instead of in wireDecode
+   *
+   * Code paths that only need the Name (e.g., content store lookups) do not pay for
+   * decoding MetaInfo, SignatureInfo, and KeyLocator.  wireDecode still checks these fields
+   * with MetaInfo::validate and SignatureInfo::validate, so a malformed packet is rejected
+   * there and getMetaInfo and getSignature do not throw.
+   */
+  enum PendingDecodeField : uint8_t {
+    PENDING_META_INFO = 1 << 0,
+    PENDING_SIGNATURE = 1 << 1
+  };
+
+  /**
+   * @brief Decoded fields and wire encoding of the Data packet
+   *
+   * The core is shared between copies of a Data packet, so that copying is O(1)
+   * regardless of the packet size.  Every modifying method detaches the core first,
+   * and const methods cache the wire encoding and lazily decoded fields only in a core
+   * that is not shared (see shareCore), so a shared core is never written.
+   */
+  struct Core
+  {
+    Core();
+
+    Name name;
+    MetaInfo metaInfo;
+    Block content;
+    Signature signature;
+    /* PDRM Change */
+    bool unsolicited;
+    /* PDRM Change */
+
+    Block wire;
+    uint8_t pendingDecode;
+  };
 
-  mutable Block m_wire;
+  shared_ptr<Core> m_core;
+  /// cached by getFullName; kept out of the core, so that computing it never writes a shared core
   mutable Name m_fullName;
 
   nfd::LocalControlHeader m_localControlHeader;
@@ -347,43 +445,47 @@ operator<<(std::ostream& os, const Data& data);
 inline bool
 Data::hasWire() const
 {
-  return m_wire.hasWire();
+  return m_core->wire.hasWire();
 }
 
 inline const Name&
 Data::getName() const
 {
-  return m_name;
+  return m_core->name;
 }
 
 inline const MetaInfo&
 Data::getMetaInfo() const
 {
-  return m_metaInfo;
+  if (m_core->pendingDecode & PENDING_META_INFO)
+    decodePendingMetaInfo();
+  return m_core->metaInfo;
 }
 
 inline uint32_t
 Data::getContentType() const
 {
-  return m_metaInfo.getType();
+  return getMetaInfo().getType();
 }
 
 inline const time::milliseconds&
 Data::getFreshnessPeriod() const
 {
-  return m_metaInfo.getFreshnessPeriod();
+  return getMetaInfo().getFreshnessPeriod();
 }
 
 inline const name::Component&
 Data::getFinalBlockId() const
 {
-  return m_metaInfo.getFinalBlockId();
+  return getMetaInfo().getFinalBlockId();
 }
 
 inline const Signature&
 Data::getSignature() const
 {
-  return m_signature;
+  if (m_core->pendingDecode & PENDING_SIGNATURE)
+    decodePendingSignature();
+  return m_core->signature;
 }
 
 inline nfd::LocalControlHeader&
@@ -414,7 +516,7 @@ Data::getCachingPolicy() const
 inline bool
 Data::getUnsolicited() const
 {
-  return m_unsolicited;
+  return m_core->unsolicited;
 }
 /* PDRM Change */
 
@@ -24,16 +24,23 @@
 
 #include "../common.hpp"
 #include "../face.hpp"
+#include "../face-metrics.hpp"
 
 #include "registered-prefix.hpp"
+#include "interest-filter-table.hpp"
 #include "pending-interest.hpp"
+#include "pending-interest-table.hpp"
+#include "timer-wheel.hpp"
+#include "mpsc-queue.hpp"
 #include "container-with-on-empty-signal.hpp"
 
 #include "../util/scheduler.hpp"
+#include "../util/scheduler-scoped-event-id.hpp"
 #include "../util/config-file.hpp"
 #include "../util/signal.hpp"
 
 #include "../transport/transport.hpp"
+#include "../transport/send-queue-monitor.hpp"
 #include "../transport/unix-transport.hpp"
 #include "../transport/tcp-transport.hpp"
 
@@ -43,6 +50,7 @@
 #include <ns3/ptr.h>
 #include <ns3/node.h>
 #include <ns3/node-list.h>
+#include <ns3/simulator.h>
 #include <ns3/ndnSIM/model/ndn-l3-protocol.hpp>
 
 #include "ns3/ndnSIM/NFD/daemon/face/local-face.hpp"
@@ -52,10 +60,19 @@ namespace ndn {
 class Face::Impl : noncopyable
 {
 public:
-  typedef ContainerWithOnEmptySignal<shared_ptr<PendingInterest>> PendingInterestTable;
-  typedef std::list<shared_ptr<InterestFilterRecord> > InterestFilterTable;
   typedef ContainerWithOnEmptySignal<shared_ptr<RegisteredPrefix>> RegisteredPrefixTable;
 
+  /**
+   * @brief Interest or Data submitted from another thread
+   */
+  struct Submission
+  {
+    shared_ptr<const Interest> interest;
+    OnData onData;
+    OnTimeout onTimeout;
+    shared_ptr<const Data> data;
+  };
+
   class NfdFace : public ::nfd::LocalFace
   {
   public:
@@ -73,6 +90,12 @@ public:
     sendInterest(const Interest& interest)
     {
       NS_LOG_DEBUG("<< Interest " << interest);
+      if (m_appFaceImpl.canDeliverDirectly()) {
+        DirectCall call;
+        m_appFaceImpl.processInterestFilters(interest);
+        return;
+      }
+
       shared_ptr<const Interest> interestPtr = interest.shared_from_this();
       m_appFaceImpl.m_scheduler.scheduleEvent(time::seconds(0), [this, interestPtr] {
           m_appFaceImpl.processInterestFilters(*interestPtr);
@@ -86,6 +109,12 @@ public:
     sendData(const Data& data)
     {
       NS_LOG_DEBUG("<< Data " << data.getName());
+      if (m_appFaceImpl.canDeliverDirectly()) {
+        DirectCall call;
+        m_appFaceImpl.satisfyPendingInterests(data);
+        return;
+      }
+
       shared_ptr<const Data> dataPtr = data.shared_from_this();
       m_appFaceImpl.m_scheduler.scheduleEvent(time::seconds(0), [this, dataPtr] {
           m_appFaceImpl.satisfyPendingInterests(*dataPtr);
@@ -108,12 +137,55 @@ public:
     Impl& m_appFaceImpl;
   };
 
+  /**
+   * @brief Marks every face as busy while a packet is processed synchronously
+   *
+   * The depth is shared by all faces of the thread, i.e., of the simulation: a packet
+   * delivered directly by one face reaches the forwarder, which may deliver it directly to
+   * another face, whose callbacks may send through the first face again.
+   */
+  class DirectCall : noncopyable
+  {
+  public:
+    DirectCall()
+    {
+      ++getDepth();
+    }
+
+    ~DirectCall()
+    {
+      --getDepth();
+    }
+
+    /**
+     * @return nesting depth of synchronously processed packets on any face of this thread
+     */
+    static size_t&
+    getDepth()
+    {
+      static thread_local size_t depth = 0;
+      return depth;
+    }
+  };
+
   ////////////////////////////////////////////////////////////////////////
 
   explicit
   Impl(Face& face)
     : m_face(face)
-    , m_scheduler(m_face.getIoService())
+    , m_scheduler()
+    , m_timeoutWheel(m_scheduler)
+    , m_isDirectDelivery(false)
+    , m_isInterestAggregation(false)
+    , m_metricsDumpInterval(time::nanoseconds::zero())
+    , m_metricsDumpEvent(m_scheduler)
+    , m_isSubmissionPolling(false)
+    , m_isSubmissionPollScheduled(false)
+    , m_submissionPollInterval(time::nanoseconds::zero())
+    , m_submissionPollBatchSize(0)
+    , m_submissionPollEvent(m_scheduler)
+    , m_context(ns3::Simulator::GetContext())
+    , m_self(this, [] (Impl*) {})
   {
     ns3::Ptr<ns3::Node> node = ns3::NodeList::GetNode(ns3::Simulator::GetContext());
     NS_ASSERT_MSG(node->GetObject<ns3::ndn::L3Protocol>() != 0,
@@ -123,34 +195,86 @@ public:
     m_nfdFace = make_shared<NfdFace>(*this, uri, uri);
 
     node->GetObject<ns3::ndn::L3Protocol>()->addFace(m_nfdFace);
+
+    m_sendQueueMonitor.setWritabilityCallback([this] (bool isWritable) {
+        if (isWritable) {
+          m_face.onWritable();
+        }
+        else {
+          m_face.onUnwritable();
+        }
+      });
   }
 
   /////////////////////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////////////////////
 
+  /**
+   * @return whether a packet can be processed synchronously: direct delivery is enabled and
+   *         no packet of any face is being processed, so neither a callback nor the
+   *         forwarder is re-entered
+   */
+  bool
+  canDeliverDirectly() const
+  {
+    return m_isDirectDelivery && DirectCall::getDepth() == 0;
+  }
+
+  /**
+   * @brief Run @p operation now if direct delivery allows it, otherwise from a zero-delay event
+   *
+   * A deferred operation sending @p nPackets packets of @p nBytes bytes in total is accounted
+   * in the send queue until its event runs.
+   */
+  template<typename Operation>
   void
-  satisfyPendingInterests(const Data& data)
+  dispatch(size_t nBytes, size_t nPackets, Operation&& operation)
   {
-    for (auto entry = m_pendingInterestTable.begin(); entry != m_pendingInterestTable.end(); ) {
-      if ((*entry)->getInterest().matchesData(data)) {
-        shared_ptr<PendingInterest> matchedEntry = *entry;
+    if (canDeliverDirectly()) {
+      DirectCall call;
+      operation();
+      return;
+    }
 
-        entry = m_pendingInterestTable.erase(entry);
+    m_sendQueueMonitor.enqueue(nBytes, nPackets);
+    typename std::decay<Operation>::type deferred(std::forward<Operation>(operation));
+    m_scheduler.scheduleEvent(time::seconds(0), [this, nBytes, nPackets, deferred] {
+        m_sendQueueMonitor.dequeue(nBytes, nPackets);
+        deferred();
+      });
+  }
 
-        matchedEntry->invokeDataCallback(data);
-      }
-      else
-        ++entry;
+  /////////////////////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////////////////////////////////////////////////////////////////////////
+
+  void
+  satisfyPendingInterests(const Data& data)
+  {
+    // matched entries are removed before any callback runs, so that a callback which
+    // expresses or removes Interests does not disturb this iteration
+    ++m_metrics.nReceivedData;
+    m_metrics.nInBytes += data.wireEncode().size();
+
+    time::steady_clock::TimePoint now = time::steady_clock::now();
+    for (const auto& matchedEntry : m_pendingInterestTable.extractMatching(data)) {
+      ++m_metrics.nSatisfiedInterests;
+      m_metrics.interestRtt.add(now - matchedEntry->getExpressTime());
+      matchedEntry->invokeDataCallback(data);
     }
   }
 
   void
   processInterestFilters(const Interest& interest)
   {
-    for (const auto& filter : m_interestFilterTable) {
-      if (filter->doesMatch(interest.getName())) {
-        filter->invokeInterestCallback(interest);
-      }
+    ++m_metrics.nReceivedInterests;
+    m_metrics.nInBytes += interest.wireEncode().size();
+
+    for (const auto& filter : m_interestFilterTable.findMatches(interest.getName())) {
+      ++m_metrics.nInterestFilterHits;
+      // simulated time does not advance during a callback, so the wall clock is used
+      boost::chrono::steady_clock::time_point start = boost::chrono::steady_clock::now();
+      filter->invokeInterestCallback(interest);
+      m_metrics.interestFilterDispatchTime.add(boost::chrono::steady_clock::now() - start);
     }
   }
 
@@ -164,27 +288,185 @@ public:
     auto entry =
       m_pendingInterestTable.insert(make_shared<PendingInterest>(interest,
                                                                  onData, onTimeout,
-                                                                 ref(m_scheduler))).first;
-    (*entry)->setDeleter([this, entry] { m_pendingInterestTable.erase(entry); });
+                                                                 ref(m_timeoutWheel))).first;
+    (*entry)->setDeleter([this, entry] {
+        ++m_metrics.nTimedOutInterests;
+        shared_ptr<PendingInterest> timedOut = *entry;
+        m_pendingInterestTable.erase(entry);
+        if (timedOut->isForwarded()) {
+          forwardAggregatedInterest(timedOut->getInterest());
+        }
+      });
+
+    ++m_metrics.nExpressedInterests;
+
+    if (m_isInterestAggregation &&
+        m_pendingInterestTable.findSimilar(*interest, [] (const PendingInterest& similar) {
+            return similar.isForwarded();
+          }) != m_pendingInterestTable.end()) {
+      // Data for the forwarded Interest satisfies this one as well
+      ++m_metrics.nAggregatedInterests;
+      return;
+    }
+
+    forwardInterest(**entry);
+  }
 
-    m_nfdFace->emitSignal(onReceiveInterest, *interest);
+  void
+  forwardInterest(PendingInterest& entry)
+  {
+    entry.setForwarded();
+    m_metrics.nOutBytes += entry.getInterest().wireEncode().size();
+
+    m_nfdFace->emitSignal(onReceiveInterest, entry.getInterest());
+  }
+
+  /**
+   * @brief Forward the earliest Interest aggregated with @p interest, if any
+   *
+   * Called when the forwarded @p interest is removed before Data arrives, so that the
+   * Interests that have not timed out yet keep an Interest in the network.
+   */
+  void
+  forwardAggregatedInterest(const Interest& interest)
+  {
+    auto aggregated = m_pendingInterestTable.findSimilar(interest,
+                                                         [] (const PendingInterest& similar) {
+                                                           return !similar.isForwarded();
+                                                         });
+    if (aggregated != m_pendingInterestTable.end()) {
+      forwardInterest(**aggregated);
+    }
   }
 
   void
   asyncRemovePendingInterest(const PendingInterestId* pendingInterestId)
   {
-    m_pendingInterestTable.remove_if(MatchPendingInterestId(pendingInterestId));
+    shared_ptr<PendingInterest> removed = m_pendingInterestTable.removeById(pendingInterestId);
+    if (removed != nullptr) {
+      ++m_metrics.nCancelledInterests;
+      if (removed->isForwarded()) {
+        forwardAggregatedInterest(removed->getInterest());
+      }
+    }
+  }
+
+  void
+  asyncRemoveAllPendingInterests(const Name& prefix)
+  {
+    m_metrics.nCancelledInterests += m_pendingInterestTable.removeByPrefix(prefix);
   }
 
   void
   asyncPutData(const shared_ptr<const Data>& data)
   {
+    ++m_metrics.nPutData;
+    m_metrics.nOutBytes += data->wireEncode().size();
+
     m_nfdFace->emitSignal(onReceiveData, *data);
   }
 
   /////////////////////////////////////////////////////////////////////////////////////////////////
   /////////////////////////////////////////////////////////////////////////////////////////////////
 
+  void
+  scheduleMetricsDump()
+  {
+    m_metricsDumpEvent = m_scheduler.scheduleEvent(m_metricsDumpInterval, [this] {
+        this->scheduleMetricsDump();
+        m_metricsDumpCallback(m_metrics);
+      });
+  }
+
+  size_t
+  processSubmissions(size_t maxBatchSize)
+  {
+    size_t nProcessed = 0;
+    Submission submission;
+    while (nProcessed < maxBatchSize && m_submissions.tryPop(submission)) {
+      ++nProcessed;
+      if (submission.interest != nullptr) {
+        asyncExpressInterest(submission.interest, submission.onData, submission.onTimeout);
+      }
+      else {
+        asyncPutData(submission.data);
+      }
+    }
+    return nProcessed;
+  }
+
+  /**
+   * @brief Queue @p submission; can be called from any thread
+   *
+   * If polling is enabled but stopped because the queue ran empty, it is started again
+   * through ns3::Simulator::ScheduleWithContext, which accepts events from other threads.
+   */
+  void
+  submit(Submission&& submission)
+  {
+    m_submissions.push(std::move(submission));
+
+    // pairs with the fence in pollSubmissions: either the poll sees this submission, or
+    // this sees that no poll is scheduled
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_isSubmissionPolling.load(std::memory_order_relaxed) &&
+        !m_isSubmissionPollScheduled.exchange(true)) {
+      ns3::Simulator::ScheduleWithContext(m_context, ns3::Seconds(0), &Impl::restartSubmissionPoll,
+                                          weak_ptr<Impl>(m_self));
+    }
+  }
+
+  /**
+   * @brief Start polling again after a submission from another thread
+   */
+  static void
+  restartSubmissionPoll(const weak_ptr<Impl>& weakImpl)
+  {
+    shared_ptr<Impl> impl = weakImpl.lock();
+    if (impl == nullptr) {
+      return;
+    }
+
+    if (impl->m_isSubmissionPolling) {
+      impl->scheduleSubmissionPoll();
+    }
+    else {
+      impl->m_isSubmissionPollScheduled = false;
+    }
+  }
+
+  void
+  scheduleSubmissionPoll()
+  {
+    m_submissionPollEvent = m_scheduler.scheduleEvent(m_submissionPollInterval, [this] {
+        this->pollSubmissions();
+      });
+  }
+
+  /**
+   * @brief Process a batch of submissions, and poll again only if some are left
+   *
+   * A poll that rescheduled itself unconditionally would keep Simulator::Run from returning.
+   */
+  void
+  pollSubmissions()
+  {
+    processSubmissions(m_submissionPollBatchSize);
+
+    if (m_submissions.isEmpty()) {
+      m_isSubmissionPollScheduled = false;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      // a submission that saw the flag still set did not restart the poll
+      if (m_submissions.isEmpty() || m_isSubmissionPollScheduled.exchange(true)) {
+        return;
+      }
+    }
+    scheduleSubmissionPoll();
+  }
+
+  /////////////////////////////////////////////////////////////////////////////////////////////////
+  /////////////////////////////////////////////////////////////////////////////////////////////////
+
   void
   asyncSetInterestFilter(const shared_ptr<InterestFilterRecord>& interestFilterRecord)
   {
@@ -194,13 +476,7 @@ public:
   void
   asyncUnsetInterestFilter(const InterestFilterId* interestFilterId)
   {
-    InterestFilterTable::iterator i = std::find_if(m_interestFilterTable.begin(),
-                                                   m_interestFilterTable.end(),
-                                                   MatchInterestFilterId(interestFilterId));
-    if (i != m_interestFilterTable.end())
-      {
-        m_interestFilterTable.erase(i);
-      }
+    m_interestFilterTable.removeById(interestFilterId);
   }
 
   /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -296,13 +572,36 @@ public:
 private:
   Face& m_face;
   util::Scheduler m_scheduler;
+  TimerWheel m_timeoutWheel; ///< Interest timeouts, shared to use a single scheduler event
 
   PendingInterestTable m_pendingInterestTable;
-  InterestFilterTable m_interestFilterTable;
+  InterestFilterTable<> m_interestFilterTable;
   RegisteredPrefixTable m_registeredPrefixTable;
 
   shared_ptr<NfdFace> m_nfdFace;
 
+  bool m_isDirectDelivery;
+  bool m_isInterestAggregation;
+  SendQueueMonitor m_sendQueueMonitor; ///< packets waiting in zero-delay events
+
+  FaceMetrics m_metrics;
+  time::nanoseconds m_metricsDumpInterval;
+  function<void(const FaceMetrics&)> m_metricsDumpCallback;
+  util::scheduler::ScopedEventId m_metricsDumpEvent;
+
+  /// accessed from other threads, like the two flags that follow
+  MpscQueue<Submission> m_submissions;
+  std::atomic<bool> m_isSubmissionPolling;
+  /// whether a poll is scheduled or about to be, so that only one submitter restarts it
+  std::atomic<bool> m_isSubmissionPollScheduled;
+  time::nanoseconds m_submissionPollInterval;
+  size_t m_submissionPollBatchSize;
+  util::scheduler::ScopedEventId m_submissionPollEvent;
+  uint32_t m_context; ///< simulator context of the node, for events scheduled by other threads
+  /// does not own this Impl, but expires with it, so that restartSubmissionPoll can tell
+  /// whether the face still exists
+  shared_ptr<Impl> m_self;
+
   friend class Face;
 };
 
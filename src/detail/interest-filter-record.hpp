@@ -25,6 +25,8 @@
 #include "../common.hpp"
 #include "../name.hpp"
 #include "../interest.hpp"
+#include "../interest-filter.hpp"
+#include "../util/callback-profiler.hpp"
 
 namespace ndn {
 
@@ -56,6 +58,8 @@ public:
   void
   invokeInterestCallback(const Interest& interest) const
   {
+    NDN_PROFILE_CALLBACK(util::CallbackProfiler::ON_INTEREST, interest.getName(),
+                         m_filter.getPrefix());
     m_afterInterest(m_filter, interest);
   }
 
@@ -0,0 +1,184 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+#define NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
+
+#include "../common.hpp"
+#include "interest-filter-record.hpp"
+#include "name-prefix-hash.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief Table of InterestFilters set on a Face
+ *
+ * Records are indexed by the prefix of their filter, so that an incoming Interest is only
+ * tested against the filters whose prefix is a prefix of the Interest name.  The regular
+ * expression of a filter, if any, is evaluated only for those filters.
+ *
+ * @tparam PrefixHash hash of name prefixes, with the interface of NamePrefixHash
+ */
+template<typename PrefixHash = NamePrefixHash>
+class InterestFilterTable : noncopyable
+{
+public:
+  typedef shared_ptr<InterestFilterRecord> value_type;
+  typedef std::list<value_type> Base;
+  typedef typename Base::iterator iterator;
+
+  iterator
+  begin()
+  {
+    return m_records.begin();
+  }
+
+  iterator
+  end()
+  {
+    return m_records.end();
+  }
+
+  size_t
+  size() const
+  {
+    return m_records.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_records.empty();
+  }
+
+  void
+  push_back(const value_type& record)
+  {
+    iterator item = m_records.insert(m_records.end(), record);
+    m_index.insert({PrefixHash::compute(record->getFilter().getPrefix()),
+                    IndexEntry{item, m_nextSeq++}});
+    m_idIndex.insert({getId(record), item});
+  }
+
+  /**
+   * @brief Remove @p record, if it is in the table
+   */
+  void
+  remove(const value_type& record)
+  {
+    this->removeById(getId(record));
+  }
+
+  /**
+   * @brief Remove the record with the specified id
+   * @return whether a record was removed
+   */
+  bool
+  removeById(const InterestFilterId* interestFilterId)
+  {
+    auto entry = m_idIndex.find(interestFilterId);
+    if (entry == m_idIndex.end()) {
+      return false;
+    }
+    iterator item = entry->second;
+    m_idIndex.erase(entry);
+
+    auto range = m_index.equal_range(PrefixHash::compute((*item)->getFilter().getPrefix()));
+    for (auto indexEntry = range.first; indexEntry != range.second; ++indexEntry) {
+      if (indexEntry->second.item == item) {
+        m_index.erase(indexEntry);
+        break;
+      }
+    }
+
+    m_records.erase(item);
+    return true;
+  }
+
+  /**
+   * @brief Find the records whose filter matches @p name
+   * @return the matching records, in the order they were added
+   */
+  std::vector<value_type>
+  findMatches(const Name& name) const
+  {
+    std::vector<IndexEntry> matches;
+
+    size_t key = PrefixHash::compute(name, 0);
+    for (size_t i = 0; ; ++i) {
+      auto range = m_index.equal_range(key);
+      for (auto entry = range.first; entry != range.second; ++entry) {
+        if ((*entry->second.item)->doesMatch(name)) {
+          matches.push_back(entry->second);
+        }
+      }
+
+      if (i == name.size())
+        break;
+      key = PrefixHash::extend(key, name[i]);
+    }
+
+    if (matches.size() > 1) {
+      std::sort(matches.begin(), matches.end(),
+                [] (const IndexEntry& a, const IndexEntry& b) { return a.seq < b.seq; });
+      // two prefixes of the name may have the same hash, and thus find the same record
+      matches.erase(std::unique(matches.begin(), matches.end(),
+                                [] (const IndexEntry& a, const IndexEntry& b) {
+                                  return a.seq == b.seq;
+                                }),
+                    matches.end());
+    }
+
+    std::vector<value_type> records;
+    records.reserve(matches.size());
+    for (const IndexEntry& match : matches) {
+      records.push_back(*match.item);
+    }
+    return records;
+  }
+
+private:
+  struct IndexEntry
+  {
+    iterator item;
+    uint64_t seq; ///< insertion order
+  };
+
+  static const InterestFilterId*
+  getId(const value_type& record)
+  {
+    // same as MatchInterestFilterId
+    return reinterpret_cast<const InterestFilterId*>(record.get());
+  }
+
+private:
+  Base m_records;
+  std::unordered_multimap<size_t, IndexEntry> m_index;
+  std::unordered_map<const InterestFilterId*, iterator> m_idIndex;
+  uint64_t m_nextSeq = 0;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_INTEREST_FILTER_TABLE_HPP
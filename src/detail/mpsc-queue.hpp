@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_MPSC_QUEUE_HPP
+#define NDN_DETAIL_MPSC_QUEUE_HPP
+
+#include "../common.hpp"
+
+#include <atomic>
+
+namespace ndn {
+
+/**
+ * @brief Unbounded multi-producer single-consumer queue without locks
+ *
+ * Any number of threads can push concurrently; push is wait-free and costs one allocation and
+ * one atomic exchange.  A single consumer thread pops in FIFO order per producer.  The queue is
+ * a singly linked list whose head is swapped by producers, so an element whose producer has
+ * swapped the head but not yet linked it is not visible to tryPop until linking completes,
+ * which also hides the elements pushed after it.
+ */
+template<typename T>
+class MpscQueue : noncopyable
+{
+private:
+  struct Node
+  {
+    Node()
+      : next(nullptr)
+    {
+    }
+
+    explicit
+    Node(T&& value)
+      : next(nullptr)
+      , value(std::move(value))
+    {
+    }
+
+    std::atomic<Node*> next;
+    T value;
+  };
+
+public:
+  MpscQueue()
+    : m_head(new Node)
+    , m_tail(m_head.load(std::memory_order_relaxed))
+  {
+  }
+
+  ~MpscQueue()
+  {
+    while (m_tail != nullptr) {
+      Node* next = m_tail->next.load(std::memory_order_relaxed);
+      delete m_tail;
+      m_tail = next;
+    }
+  }
+
+  /**
+   * @brief Append @p value; can be called from any thread
+   */
+  void
+  push(T value)
+  {
+    Node* node = new Node(std::move(value));
+    Node* previous = m_head.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+  }
+
+  /**
+   * @brief Remove the oldest visible element into @p value; must be called from the consumer
+   * @return false if no element is visible
+   */
+  bool
+  tryPop(T& value)
+  {
+    Node* next = m_tail->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return false;
+    }
+
+    // next becomes the new sentinel, so its value is moved out and left empty
+    value = std::move(next->value);
+    delete m_tail;
+    m_tail = next;
+    return true;
+  }
+
+  /**
+   * @return whether no element is visible; must be called from the consumer
+   */
+  bool
+  isEmpty() const
+  {
+    return m_tail->next.load(std::memory_order_acquire) == nullptr;
+  }
+
+private:
+  std::atomic<Node*> m_head; ///< most recently pushed node, swapped by producers
+  Node* m_tail; ///< sentinel preceding the oldest element, owned by the consumer
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_MPSC_QUEUE_HPP
@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_NAME_PREFIX_HASH_HPP
+#define NDN_DETAIL_NAME_PREFIX_HASH_HPP
+
+#include "../common.hpp"
+#include "../name.hpp"
+
+#include <boost/functional/hash.hpp>
+
+namespace ndn {
+
+/**
+ * @brief Hash of a name that is built one component at a time
+ *
+ * Because the hash of a prefix is extended by each following component, the hashes of all
+ * prefixes of a name are obtained in a single pass over the name.  Tables keyed by this hash
+ * thus find the entries along the prefix chain of a name with one lookup per component,
+ * like a walk down a name tree.  Different names may have the same hash, so the entries
+ * found this way must still be checked against the name.
+ */
+class NamePrefixHash
+{
+public:
+  /**
+   * @brief Hash of the first @p nComponents components of @p name
+   */
+  static size_t
+  compute(const Name& name, size_t nComponents)
+  {
+    BOOST_ASSERT(nComponents <= name.size());
+
+    size_t hash = 0;
+    for (size_t i = 0; i < nComponents; ++i) {
+      hash = extend(hash, name[i]);
+    }
+    return hash;
+  }
+
+  static size_t
+  compute(const Name& name)
+  {
+    return compute(name, name.size());
+  }
+
+  /**
+   * @brief Hash of a prefix with hash @p hash followed by @p component
+   */
+  static size_t
+  extend(size_t hash, const name::Component& component)
+  {
+    boost::hash_combine(hash, component.type());
+    boost::hash_range(hash, component.value_begin(), component.value_end());
+    return hash;
+  }
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_NAME_PREFIX_HASH_HPP
@@ -0,0 +1,294 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+#define NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
+
+#include "../common.hpp"
+#include "../util/signal.hpp"
+#include "pending-interest.hpp"
+#include "name-prefix-hash.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace ndn {
+
+/**
+ * @brief Table of Interests expressed by a Face and waiting for Data
+ *
+ * Entries are kept in the order they were inserted.  In addition, every entry is indexed
+ * by a hash of its Interest name, so that an incoming Data is only checked against the
+ * Interests whose name could be a prefix of the Data name, instead of every pending Interest,
+ * and by its PendingInterestId, so that an Interest can be cancelled in constant time.
+ *
+ * Like ContainerWithOnEmptySignal, the table fires onEmpty when the last entry is removed.
+ */
+class PendingInterestTable : noncopyable
+{
+public:
+  typedef shared_ptr<PendingInterest> value_type;
+  typedef std::list<value_type> Base;
+  typedef Base::iterator iterator;
+
+  iterator
+  begin()
+  {
+    return m_entries.begin();
+  }
+
+  iterator
+  end()
+  {
+    return m_entries.end();
+  }
+
+  size_t
+  size()
+  {
+    return m_entries.size();
+  }
+
+  bool
+  empty()
+  {
+    return m_entries.empty();
+  }
+
+  std::pair<iterator, bool>
+  insert(const value_type& value)
+  {
+    iterator item = m_entries.insert(m_entries.end(), value);
+    m_index.insert({computeKey(value->getInterest().getName()), IndexEntry{item, m_nextSeq++}});
+    m_idIndex.insert({getId(*value), item});
+    return {item, true};
+  }
+
+  iterator
+  erase(iterator item)
+  {
+    this->unindex(item);
+    iterator next = m_entries.erase(item);
+    if (empty()) {
+      this->onEmpty();
+    }
+    return next;
+  }
+
+  void
+  clear()
+  {
+    m_index.clear();
+    m_idIndex.clear();
+    m_entries.clear();
+    this->onEmpty();
+  }
+
+  template<class Predicate>
+  void
+  remove_if(Predicate p)
+  {
+    for (iterator item = m_entries.begin(); item != m_entries.end(); ) {
+      if (p(*item)) {
+        this->unindex(item);
+        item = m_entries.erase(item);
+      }
+      else {
+        ++item;
+      }
+    }
+    if (empty()) {
+      this->onEmpty();
+    }
+  }
+
+  /**
+   * @brief Remove the entry with the specified id
+   * @return the removed entry, or nullptr if there is no such entry
+   */
+  value_type
+  removeById(const PendingInterestId* pendingInterestId)
+  {
+    auto entry = m_idIndex.find(pendingInterestId);
+    if (entry == m_idIndex.end()) {
+      return nullptr;
+    }
+    value_type removed = *entry->second;
+    this->erase(entry->second);
+    return removed;
+  }
+
+  /**
+   * @brief Find the earliest inserted entry whose Interest has the same Name and Selectors
+   *        as @p interest and that satisfies @p predicate
+   * @return the entry, or end() if there is none
+   */
+  template<class Predicate>
+  iterator
+  findSimilar(const Interest& interest, Predicate predicate)
+  {
+    const IndexEntry* found = nullptr;
+    auto range = m_index.equal_range(computeKey(interest.getName()));
+    for (auto entry = range.first; entry != range.second; ++entry) {
+      const PendingInterest& candidate = **entry->second.item;
+      if ((found == nullptr || entry->second.seq < found->seq) &&
+          candidate.getInterest().getName() == interest.getName() &&
+          candidate.getInterest().getSelectors() == interest.getSelectors() &&
+          predicate(candidate)) {
+        found = &entry->second;
+      }
+    }
+    return found == nullptr ? m_entries.end() : found->item;
+  }
+
+  /**
+   * @brief Remove all entries whose Interest name starts with @p prefix
+   * @return number of removed entries
+   */
+  size_t
+  removeByPrefix(const Name& prefix)
+  {
+    size_t nRemoved = 0;
+    for (iterator item = m_entries.begin(); item != m_entries.end(); ) {
+      if (prefix.isPrefixOf((*item)->getInterest().getName())) {
+        this->unindex(item);
+        item = m_entries.erase(item);
+        ++nRemoved;
+      }
+      else {
+        ++item;
+      }
+    }
+    if (nRemoved > 0 && empty()) {
+      this->onEmpty();
+    }
+    return nRemoved;
+  }
+
+  /**
+   * @brief Remove all entries whose Interest matches @p data
+   * @return the removed entries, in the order they were inserted
+   *
+   * Only entries indexed under a prefix of the Data name are evaluated with
+   * Interest::matchesData.  An Interest whose name ends with an implicit digest is indexed
+   * under the name without the digest, so it is found through the Data name as well.
+   */
+  std::vector<value_type>
+  extractMatching(const Data& data)
+  {
+    std::vector<IndexEntry> matches;
+
+    const Name& name = data.getName();
+    size_t key = NamePrefixHash::compute(name, 0);
+    for (size_t i = 0; ; ++i) {
+      auto range = m_index.equal_range(key);
+      for (auto entry = range.first; entry != range.second; ++entry) {
+        if ((*entry->second.item)->getInterest().matchesData(data)) {
+          matches.push_back(entry->second);
+        }
+      }
+
+      if (i == name.size())
+        break;
+      key = NamePrefixHash::extend(key, name[i]);
+    }
+
+    if (matches.size() > 1) {
+      std::sort(matches.begin(), matches.end(),
+                [] (const IndexEntry& a, const IndexEntry& b) { return a.seq < b.seq; });
+      // two prefixes of the Data name may have the same hash, and thus find the same entry
+      matches.erase(std::unique(matches.begin(), matches.end(),
+                                [] (const IndexEntry& a, const IndexEntry& b) {
+                                  return a.seq == b.seq;
+                                }),
+                    matches.end());
+    }
+
+    std::vector<value_type> extracted;
+    extracted.reserve(matches.size());
+    for (const IndexEntry& match : matches) {
+      extracted.push_back(*match.item);
+      this->erase(match.item);
+    }
+    return extracted;
+  }
+
+private:
+  struct IndexEntry
+  {
+    iterator item;
+    uint64_t seq; ///< insertion order
+  };
+
+  /**
+   * @brief Compute the index key of an Interest name
+   *
+   * A trailing implicit digest is not part of the key, so that the entry is found through
+   * the Data name.
+   */
+  static size_t
+  computeKey(const Name& name)
+  {
+    size_t nComponents = name.size();
+    if (nComponents > 0 && name[-1].isImplicitSha256Digest()) {
+      --nComponents;
+    }
+    return NamePrefixHash::compute(name, nComponents);
+  }
+
+  static const PendingInterestId*
+  getId(const PendingInterest& pendingInterest)
+  {
+    // same as MatchPendingInterestId
+    return reinterpret_cast<const PendingInterestId*>(&pendingInterest.getInterest());
+  }
+
+  void
+  unindex(iterator item)
+  {
+    m_idIndex.erase(getId(**item));
+
+    auto range = m_index.equal_range(computeKey((*item)->getInterest().getName()));
+    for (auto entry = range.first; entry != range.second; ++entry) {
+      if (entry->second.item == item) {
+        m_index.erase(entry);
+        return;
+      }
+    }
+    BOOST_ASSERT(false);
+  }
+
+public:
+  /**
+   * @brief Signal to be fired when table becomes empty
+   */
+  util::Signal<PendingInterestTable> onEmpty;
+
+private:
+  Base m_entries;
+  std::unordered_multimap<size_t, IndexEntry> m_index;
+  std::unordered_map<const PendingInterestId*, iterator> m_idIndex;
+  uint64_t m_nextSeq = 0;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_PENDING_INTEREST_TABLE_HPP
@@ -26,8 +26,8 @@
 #include "../interest.hpp"
 #include "../data.hpp"
 #include "../util/time.hpp"
-#include "../util/scheduler.hpp"
-#include "../util/scheduler-scoped-event-id.hpp"
+#include "../util/callback-profiler.hpp"
+#include "timer-wheel.hpp"
 
 namespace ndn {
 
@@ -45,21 +45,22 @@ public:
    * @param onData A function object to call when a matching data packet is received.
    * @param onTimeout A function object to call if the interest times out.
    *                  If onTimeout is an empty OnTimeout(), this does not use it.
-   * @param scheduler Scheduler instance to use to schedule a timeout event.  The scheduled
-   *                  event will be automatically cancelled when pending interest is destroyed.
+   * @param timeoutWheel TimerWheel to use to schedule the timeout.  The timeout
+   *                     will be automatically cancelled when pending interest is destroyed.
    */
   PendingInterest(shared_ptr<const Interest> interest, const OnData& onData,
-                  const OnTimeout& onTimeout, Scheduler& scheduler)
+                  const OnTimeout& onTimeout, TimerWheel& timeoutWheel)
     : m_interest(interest)
     , m_onData(onData)
     , m_onTimeout(onTimeout)
-    , m_timeoutEvent(scheduler)
+    , m_expressTime(time::steady_clock::now())
+    , m_isForwarded(false)
   {
-    m_timeoutEvent =
-      scheduler.scheduleEvent(m_interest->getInterestLifetime() > time::milliseconds::zero() ?
-                              m_interest->getInterestLifetime() :
-                              DEFAULT_INTEREST_LIFETIME,
-                              bind(&PendingInterest::invokeTimeoutCallback, this));
+    timeoutWheel.schedule(m_timeout,
+                          m_interest->getInterestLifetime() > time::milliseconds::zero() ?
+                          m_interest->getInterestLifetime() :
+                          DEFAULT_INTEREST_LIFETIME,
+                          [this] { this->invokeTimeoutCallback(); });
   }
 
   /**
@@ -71,6 +72,31 @@ public:
     return *m_interest;
   }
 
+  /**
+   * @return when the Interest was expressed
+   */
+  const time::steady_clock::TimePoint&
+  getExpressTime() const
+  {
+    return m_expressTime;
+  }
+
+  /**
+   * @return whether the Interest has been sent to the forwarder, which is not the case when
+   *         it is aggregated with a similar pending Interest
+   */
+  bool
+  isForwarded() const
+  {
+    return m_isForwarded;
+  }
+
+  void
+  setForwarded()
+  {
+    m_isForwarded = true;
+  }
+
   /**
    * @brief invokes the DataCallback
    * @note If the DataCallback is an empty function, this method does nothing.
@@ -78,6 +104,7 @@ public:
   void
   invokeDataCallback(const Data& data)
   {
+    NDN_PROFILE_CALLBACK(util::CallbackProfiler::ON_DATA, m_interest->getName());
     m_onData(*m_interest, const_cast<Data&>(data));
   }
 
@@ -99,6 +126,7 @@ private:
   invokeTimeoutCallback()
   {
     if (m_onTimeout) {
+      NDN_PROFILE_CALLBACK(util::CallbackProfiler::ON_TIMEOUT, m_interest->getName());
       m_onTimeout(*m_interest);
     }
 
@@ -110,7 +138,9 @@ private:
   shared_ptr<const Interest> m_interest;
   const OnData m_onData;
   const OnTimeout m_onTimeout;
-  util::scheduler::ScopedEventId m_timeoutEvent;
+  const time::steady_clock::TimePoint m_expressTime;
+  bool m_isForwarded;
+  TimerWheel::Timer m_timeout;
   std::function<void()> m_deleter;
 };
 
@@ -0,0 +1,345 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_TIMER_WHEEL_HPP
+#define NDN_DETAIL_TIMER_WHEEL_HPP
+
+#include "../common.hpp"
+#include "../util/time.hpp"
+#include "../util/scheduler.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Hierarchical timer wheel that multiplexes many timers onto one scheduler event
+ *
+ * Timers are kept in six levels of 64 slots.  Level 0 holds timers expiring within 64 ticks,
+ * each further level covers 64 times the range of the previous one, and the timers of a slot
+ * are moved down when the clock reaches the start of that slot.  Only the next tick at which
+ * a timer expires or a slot has to be moved down is scheduled with the Scheduler, so adding
+ * a timer that is not the next one to expire, and cancelling any timer, do not touch the
+ * simulator event queue.  Adding and cancelling a timer are O(1).
+ *
+ * Expiration is rounded up to the next tick, so a timer fires at most one tick late.
+ */
+class TimerWheel : noncopyable
+{
+private:
+  struct Node
+  {
+    Node* prev;
+    Node* next;
+  };
+
+public:
+  /**
+   * @brief A timer, meant to be embedded in the object whose timeout it represents
+   *
+   * The timer is cancelled when destroyed.
+   */
+  class Timer : private Node, noncopyable
+  {
+  public:
+    Timer()
+      : m_wheel(nullptr)
+      , m_expiry(0)
+      , m_level(0)
+      , m_slot(0)
+    {
+      prev = next = nullptr;
+    }
+
+    ~Timer()
+    {
+      cancel();
+    }
+
+    bool
+    isPending() const
+    {
+      return m_wheel != nullptr;
+    }
+
+    void
+    cancel()
+    {
+      if (m_wheel != nullptr) {
+        m_wheel->unlink(*this);
+      }
+    }
+
+  private:
+    TimerWheel* m_wheel;
+    uint64_t m_expiry; ///< absolute tick
+    uint8_t m_level;
+    uint8_t m_slot;
+    function<void()> m_callback;
+
+    friend class TimerWheel;
+  };
+
+  explicit
+  TimerWheel(Scheduler& scheduler, const time::nanoseconds& tick = time::milliseconds(1))
+    : m_scheduler(scheduler)
+    , m_tick(tick)
+    , m_size(0)
+    , m_now(currentTick())
+    , m_nextTick(NO_TICK)
+    , m_isAdvancing(false)
+  {
+    BOOST_ASSERT(tick > time::nanoseconds::zero());
+
+    for (auto& level : m_slots) {
+      for (Node& head : level) {
+        head.prev = head.next = &head;
+      }
+    }
+    std::fill(std::begin(m_occupied), std::end(m_occupied), 0);
+  }
+
+  ~TimerWheel()
+  {
+    for (auto& level : m_slots) {
+      for (Node& head : level) {
+        while (head.next != &head) {
+          unlink(static_cast<Timer&>(*head.next));
+        }
+      }
+    }
+    m_scheduler.cancelEvent(m_event);
+  }
+
+  /**
+   * @brief Start @p timer so that @p callback is invoked after @p after
+   *
+   * If @p timer is already pending, it is restarted.
+   * The timer may be destroyed from within its own callback.
+   */
+  void
+  schedule(Timer& timer, const time::nanoseconds& after, const function<void()>& callback)
+  {
+    timer.cancel();
+
+    time::nanoseconds now = time::steady_clock::now().time_since_epoch();
+    if (!m_isAdvancing) {
+      // nothing happens before m_nextTick, so the wheel can catch up with the clock
+      m_now = std::max(m_now, std::min<uint64_t>(now / m_tick, m_nextTick - 1));
+    }
+
+    time::nanoseconds deadline = now + std::max(after, time::nanoseconds::zero());
+    uint64_t expiry = (deadline.count() + m_tick.count() - 1) / m_tick.count();
+    timer.m_expiry = std::max(expiry, m_now + 1);
+    timer.m_callback = callback;
+    link(timer);
+
+    rearm();
+  }
+
+  /**
+   * @return number of pending timers
+   */
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+private:
+  static const size_t N_LEVELS = 6;
+  static const size_t SLOT_BITS = 6;
+  static const size_t N_SLOTS = 1 << SLOT_BITS;
+  static const uint64_t SLOT_MASK = N_SLOTS - 1;
+  static const uint64_t NO_TICK = std::numeric_limits<uint64_t>::max();
+
+  uint64_t
+  currentTick() const
+  {
+    return time::steady_clock::now().time_since_epoch().count() / m_tick.count();
+  }
+
+  void
+  link(Timer& timer)
+  {
+    BOOST_ASSERT(timer.m_expiry >= m_now);
+
+    uint64_t delta = timer.m_expiry - m_now;
+    size_t level = 0;
+    while (level + 1 < N_LEVELS && delta >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+      ++level;
+    }
+    // beyond the range of the last level, the slot is reached before the expiry,
+    // and the timer is simply placed again at that point
+    size_t slot = (timer.m_expiry >> (SLOT_BITS * level)) & SLOT_MASK;
+
+    Node& head = m_slots[level][slot];
+    timer.prev = head.prev;
+    timer.next = &head;
+    head.prev->next = &timer;
+    head.prev = &timer;
+    timer.m_wheel = this;
+    timer.m_level = static_cast<uint8_t>(level);
+    timer.m_slot = static_cast<uint8_t>(slot);
+    m_occupied[level] |= uint64_t(1) << slot;
+    ++m_size;
+  }
+
+  void
+  unlink(Timer& timer)
+  {
+    timer.prev->next = timer.next;
+    timer.next->prev = timer.prev;
+    timer.prev = timer.next = nullptr;
+    timer.m_wheel = nullptr;
+
+    Node& head = m_slots[timer.m_level][timer.m_slot];
+    if (head.next == &head) {
+      m_occupied[timer.m_level] &= ~(uint64_t(1) << timer.m_slot);
+    }
+    --m_size;
+  }
+
+  /**
+   * @return the first tick after m_now at which a timer expires or a slot must be moved down,
+   *         or NO_TICK if there are no timers
+   */
+  uint64_t
+  findNextTick() const
+  {
+    uint64_t next = NO_TICK;
+    for (size_t level = 0; level < N_LEVELS; ++level) {
+      if (m_occupied[level] == 0) {
+        continue;
+      }
+
+      // distance in slots from the current position to the next occupied slot, in (0, N_SLOTS]
+      size_t shift = SLOT_BITS * level;
+      uint64_t position = m_now >> shift;
+      size_t from = (position + 1) & SLOT_MASK;
+      uint64_t bits = m_occupied[level];
+      bits = from == 0 ? bits : (bits >> from) | (bits << (N_SLOTS - from));
+      uint64_t distance = 1;
+      while ((bits & 1) == 0) {
+        bits >>= 1;
+        ++distance;
+      }
+
+      next = std::min(next, (position + distance) << shift);
+    }
+    return next;
+  }
+
+  void
+  rearm()
+  {
+    if (m_isAdvancing) {
+      // rearmed once all due timers have fired
+      return;
+    }
+
+    uint64_t next = findNextTick();
+    if (next == m_nextTick) {
+      return;
+    }
+
+    m_scheduler.cancelEvent(m_event);
+    m_event.reset();
+    m_nextTick = next;
+    if (next == NO_TICK) {
+      return;
+    }
+
+    time::nanoseconds after = m_tick * static_cast<int64_t>(next) -
+                              time::steady_clock::now().time_since_epoch();
+    m_event = m_scheduler.scheduleEvent(std::max(after, time::nanoseconds::zero()),
+                                        [this] { this->onEvent(); });
+  }
+
+  void
+  onEvent()
+  {
+    m_event.reset();
+    m_nextTick = NO_TICK;
+
+    m_isAdvancing = true;
+    uint64_t target = std::max(currentTick(), m_now);
+    while (m_now < target) {
+      uint64_t next = findNextTick();
+      if (next > target) {
+        m_now = target;
+        break;
+      }
+      m_now = next;
+      processTick();
+    }
+    m_isAdvancing = false;
+
+    rearm();
+  }
+
+  /**
+   * @brief Move down the slots that start at m_now, then fire the timers expiring at m_now
+   */
+  void
+  processTick()
+  {
+    for (size_t level = N_LEVELS - 1; level > 0; --level) {
+      size_t shift = SLOT_BITS * level;
+      if ((m_now & ((uint64_t(1) << shift) - 1)) != 0) {
+        continue;
+      }
+
+      Node& head = m_slots[level][(m_now >> shift) & SLOT_MASK];
+      while (head.next != &head) {
+        Timer& timer = static_cast<Timer&>(*head.next);
+        unlink(timer);
+        link(timer);
+      }
+    }
+
+    Node& head = m_slots[0][m_now & SLOT_MASK];
+    while (head.next != &head) {
+      Timer& timer = static_cast<Timer&>(*head.next);
+      BOOST_ASSERT(timer.m_expiry == m_now);
+      unlink(timer);
+      // the timer may be destroyed by its own callback
+      function<void()> callback;
+      callback.swap(timer.m_callback);
+      callback();
+    }
+  }
+
+private:
+  Scheduler& m_scheduler;
+  const time::nanoseconds m_tick;
+
+  Node m_slots[N_LEVELS][N_SLOTS]; ///< list heads
+  uint64_t m_occupied[N_LEVELS];   ///< bitmap of non-empty slots on each level
+  size_t m_size;
+
+  uint64_t m_now;      ///< all timers expiring at or before this tick have fired
+  uint64_t m_nextTick; ///< tick of the scheduled event, no later than the first due tick
+  EventId m_event;
+  bool m_isAdvancing;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_TIMER_WHEEL_HPP
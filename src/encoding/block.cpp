@@ -252,19 +252,27 @@ Block::fromStream(std::istream& is)
 std::tuple<bool, Block>
 Block::fromBuffer(ConstBufferPtr buffer, size_t offset)
 {
+  return fromBuffer(buffer, offset, buffer->size() - offset);
+}
+
+std::tuple<bool, Block>
+Block::fromBuffer(ConstBufferPtr buffer, size_t offset, size_t maxSize)
+{
+  BOOST_ASSERT(offset + maxSize <= buffer->size());
   Buffer::const_iterator tempBegin = buffer->begin() + offset;
+  Buffer::const_iterator tempEnd = tempBegin + maxSize;
 
   uint32_t type;
-  bool isOk = tlv::readType(tempBegin, buffer->end(), type);
+  bool isOk = tlv::readType(tempBegin, tempEnd, type);
   if (!isOk)
     return std::make_tuple(false, Block());
 
   uint64_t length;
-  isOk = tlv::readVarNumber(tempBegin, buffer->end(), length);
+  isOk = tlv::readVarNumber(tempBegin, tempEnd, length);
   if (!isOk)
     return std::make_tuple(false, Block());
 
-  if (length > static_cast<uint64_t>(buffer->end() - tempBegin))
+  if (length > static_cast<uint64_t>(tempEnd - tempBegin))
     return std::make_tuple(false, Block());
 
   return std::make_tuple(true, Block(buffer, type,
@@ -147,6 +147,20 @@ public: // constructor, creation, assignment
   static std::tuple<bool, Block>
   fromBuffer(ConstBufferPtr buffer, size_t offset);
 
+  /** @brief Try to construct block from the bytes of Buffer in [offset, offset + maxSize)
+   *  @param buffer the buffer to construct block from
+   *  @param offset offset from beginning of \p buffer to construct Block from
+   *  @param maxSize the maximum size of constructed block;
+   *                 \p buffer must have a size of at least \p offset + \p maxSize
+   *
+   *  This method does not throw upon decoding error.
+   *  This method does not copy the bytes, so that a receive buffer can be sliced into Blocks.
+   *
+   *  @return true and the Block, if Block is successfully created; otherwise false
+   */
+  static std::tuple<bool, Block>
+  fromBuffer(ConstBufferPtr buffer, size_t offset, size_t maxSize);
+
   /** @deprecated use fromBuffer(ConstBufferPtr, size_t)
    */
   DEPRECATED(
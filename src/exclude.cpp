@@ -96,28 +96,44 @@ Exclude::wireEncode() const
 void
 Exclude::wireDecode(const Block& wire)
 {
-  clear();
+  decode(wire, this);
+}
+
+void
+Exclude::validate(const Block& wire)
+{
+  decode(wire, nullptr);
+}
+
+void
+Exclude::decode(const Block& wire, Exclude* exclude)
+{
+  if (exclude != nullptr)
+    exclude->clear();
 
   if (wire.type() != tlv::Exclude)
     BOOST_THROW_EXCEPTION(tlv::Error("Unexpected TLV type when decoding Exclude"));
 
-  m_wire = wire;
-  m_wire.parse();
+  if (exclude != nullptr)
+    exclude->m_wire = wire;
+  const Block& elements = exclude != nullptr ? exclude->m_wire : wire;
+  elements.parse();
 
-  if (m_wire.elements_size() == 0) {
+  if (elements.elements_size() == 0) {
     BOOST_THROW_EXCEPTION(Error("Exclude element cannot be empty"));
   }
 
   // Exclude ::= EXCLUDE-TYPE TLV-LENGTH Any? (NameComponent (Any)?)+
   // Any     ::= ANY-TYPE TLV-LENGTH(=0)
 
-  Block::element_const_iterator i = m_wire.elements_begin();
+  Block::element_const_iterator i = elements.elements_begin();
   if (i->type() == tlv::Any) {
-    appendExclude(name::Component(), true);
+    if (exclude != nullptr)
+      exclude->appendExclude(name::Component(), true);
     ++i;
   }
 
-  while (i != m_wire.elements_end()) {
+  while (i != elements.elements_end()) {
     name::Component excludedComponent;
     try {
       excludedComponent = std::move(name::Component(*i));
@@ -128,18 +144,13 @@ Exclude::wireDecode(const Block& wire)
 
     ++i;
 
-    if (i != m_wire.elements_end()) {
-      if (i->type() == tlv::Any) {
-        appendExclude(excludedComponent, true);
-        ++i;
-      }
-      else {
-        appendExclude(excludedComponent, false);
-      }
-    }
-    else {
-      appendExclude(excludedComponent, false);
+    bool isAny = false;
+    if (i != elements.elements_end() && i->type() == tlv::Any) {
+      isAny = true;
+      ++i;
     }
+    if (exclude != nullptr)
+      exclude->appendExclude(excludedComponent, isAny);
   }
 }
 
@@ -78,6 +78,17 @@ public:
   void
   wireDecode(const Block& wire);
 
+  /**
+   * @brief Check that @p wire would be accepted by wireDecode, without decoding it
+   *
+   * @p wire and its nested elements are parsed in place, so that decoding a copy of it later
+   * does not parse them again.
+   *
+   * @throws tlv::Error if @p wire is malformed
+   */
+  static void
+  validate(const Block& wire);
+
   /**
    * @brief Get escaped string representation (e.g., for use in URI) of the exclude filter
    */
@@ -198,6 +209,12 @@ private:
   Exclude&
   excludeRange(iterator fromLowerBound, iterator toLowerBound);
 
+  /**
+   * @brief Decode @p wire into @p exclude, or only check it if @p exclude is nullptr
+   */
+  static void
+  decode(const Block& wire, Exclude* exclude);
+
 private:
   exclude_type m_exclude;
 
@@ -0,0 +1,147 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "face-metrics.hpp"
+
+#include <algorithm>
+#include <ostream>
+
+namespace ndn {
+
+LatencyHistogram::LatencyHistogram()
+{
+  reset();
+}
+
+void
+LatencyHistogram::add(const time::nanoseconds& duration)
+{
+  time::nanoseconds sample = std::max(duration, time::nanoseconds::zero());
+  uint64_t value = static_cast<uint64_t>(sample.count());
+
+  size_t bucket = 0;
+  while (value > 1) {
+    value >>= 1;
+    ++bucket;
+  }
+  ++m_buckets[bucket];
+
+  if (m_count == 0 || sample < m_min) {
+    m_min = sample;
+  }
+  if (m_count == 0 || sample > m_max) {
+    m_max = sample;
+  }
+  m_sum += sample;
+  ++m_count;
+}
+
+void
+LatencyHistogram::reset()
+{
+  std::fill(m_buckets, m_buckets + N_BUCKETS, 0);
+  m_count = 0;
+  m_sum = m_min = m_max = time::nanoseconds::zero();
+}
+
+time::nanoseconds
+LatencyHistogram::getMean() const
+{
+  if (m_count == 0) {
+    return time::nanoseconds::zero();
+  }
+  return m_sum / static_cast<time::nanoseconds::rep>(m_count);
+}
+
+time::nanoseconds
+LatencyHistogram::getBucketUpperBound(size_t bucket)
+{
+  BOOST_ASSERT(bucket < N_BUCKETS);
+  if (bucket + 1 >= N_BUCKETS - 1) {
+    return time::nanoseconds::max();
+  }
+  return time::nanoseconds(time::nanoseconds::rep(1) << (bucket + 1));
+}
+
+time::nanoseconds
+LatencyHistogram::getPercentile(double percentile) const
+{
+  if (m_count == 0) {
+    return time::nanoseconds::zero();
+  }
+
+  double rank = std::min(std::max(percentile, 0.0), 100.0) / 100.0 * m_count;
+  uint64_t nSeen = 0;
+  for (size_t bucket = 0; bucket < N_BUCKETS; ++bucket) {
+    nSeen += m_buckets[bucket];
+    if (nSeen > 0 && nSeen >= rank) {
+      return std::min(getBucketUpperBound(bucket), m_max);
+    }
+  }
+  return m_max;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const LatencyHistogram& histogram)
+{
+  return os << "count=" << histogram.getCount()
+            << " min=" << histogram.getMin().count()
+            << " mean=" << histogram.getMean().count()
+            << " p50=" << histogram.getPercentile(50).count()
+            << " p99=" << histogram.getPercentile(99).count()
+            << " max=" << histogram.getMax().count() << " (ns)";
+}
+
+FaceMetrics::FaceMetrics()
+  : nExpressedInterests(0)
+  , nAggregatedInterests(0)
+  , nSatisfiedInterests(0)
+  , nTimedOutInterests(0)
+  , nCancelledInterests(0)
+  , nReceivedInterests(0)
+  , nInterestFilterHits(0)
+  , nPutData(0)
+  , nReceivedData(0)
+  , nOutBytes(0)
+  , nInBytes(0)
+{
+}
+
+std::ostream&
+operator<<(std::ostream& os, const FaceMetrics& metrics)
+{
+  os << "Interests: expressed=" << metrics.nExpressedInterests
+     << " aggregated=" << metrics.nAggregatedInterests
+     << " satisfied=" << metrics.nSatisfiedInterests
+     << " timedOut=" << metrics.nTimedOutInterests
+     << " cancelled=" << metrics.nCancelledInterests
+     << " received=" << metrics.nReceivedInterests
+     << " filterHits=" << metrics.nInterestFilterHits << "\n";
+  os << "Data: put=" << metrics.nPutData
+     << " received=" << metrics.nReceivedData << "\n";
+  os << "Bytes: out=" << metrics.nOutBytes
+     << " in=" << metrics.nInBytes << "\n";
+  os << "Interest RTT: " << metrics.interestRtt << "\n";
+  os << "InterestFilter dispatch: " << metrics.interestFilterDispatchTime << "\n";
+  return os;
+}
+
+} // namespace ndn
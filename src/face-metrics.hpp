@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_FACE_METRICS_HPP
+#define NDN_FACE_METRICS_HPP
+
+#include "common.hpp"
+#include "util/time.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Histogram of durations with power-of-two buckets
+ *
+ * Bucket 0 counts durations shorter than 2ns, and bucket i > 0 counts durations
+ * in [2^i, 2^(i+1)) nanoseconds.  Adding a sample is O(1) and does not allocate.
+ */
+class LatencyHistogram
+{
+public:
+  static const size_t N_BUCKETS = 64;
+
+  LatencyHistogram();
+
+  void
+  add(const time::nanoseconds& duration);
+
+  void
+  reset();
+
+  uint64_t
+  getCount() const
+  {
+    return m_count;
+  }
+
+  time::nanoseconds
+  getSum() const
+  {
+    return m_sum;
+  }
+
+  /**
+   * @return the shortest sample, or zero if there are no samples
+   */
+  time::nanoseconds
+  getMin() const
+  {
+    return m_count == 0 ? time::nanoseconds::zero() : m_min;
+  }
+
+  time::nanoseconds
+  getMax() const
+  {
+    return m_max;
+  }
+
+  /**
+   * @return the arithmetic mean of the samples, or zero if there are no samples
+   */
+  time::nanoseconds
+  getMean() const;
+
+  uint64_t
+  getBucketCount(size_t bucket) const
+  {
+    BOOST_ASSERT(bucket < N_BUCKETS);
+    return m_buckets[bucket];
+  }
+
+  /**
+   * @return the exclusive upper bound of durations counted in @p bucket
+   */
+  static time::nanoseconds
+  getBucketUpperBound(size_t bucket);
+
+  /**
+   * @brief Estimate a percentile of the samples
+   * @param percentile in [0, 100]
+   * @return upper bound of the bucket holding the percentile, clamped to getMax(),
+   *         or zero if there are no samples
+   */
+  time::nanoseconds
+  getPercentile(double percentile) const;
+
+private:
+  uint64_t m_buckets[N_BUCKETS];
+  uint64_t m_count;
+  time::nanoseconds m_sum;
+  time::nanoseconds m_min;
+  time::nanoseconds m_max;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const LatencyHistogram& histogram);
+
+/**
+ * @brief Packet counters and latency histograms of a Face
+ *
+ * @sa Face::getMetrics
+ */
+struct FaceMetrics
+{
+  FaceMetrics();
+
+  /// Interests expressed by the application
+  uint64_t nExpressedInterests;
+  /// expressed Interests not sent to the forwarder because a similar one was pending
+  uint64_t nAggregatedInterests;
+  /// pending Interests satisfied by incoming Data
+  uint64_t nSatisfiedInterests;
+  /// pending Interests that timed out
+  uint64_t nTimedOutInterests;
+  /// pending Interests removed by the application or by Face::shutdown
+  uint64_t nCancelledInterests;
+  /// Interests received from the forwarder
+  uint64_t nReceivedInterests;
+  /// InterestFilter callbacks invoked; an Interest may match several filters
+  uint64_t nInterestFilterHits;
+  /// Data put by the application
+  uint64_t nPutData;
+  /// Data received from the forwarder, including unsolicited Data
+  uint64_t nReceivedData;
+  /// wire size of expressed Interests and put Data
+  uint64_t nOutBytes;
+  /// wire size of received Interests and Data
+  uint64_t nInBytes;
+
+  /// time from expressing an Interest to the arrival of its Data, in simulated time
+  LatencyHistogram interestRtt;
+  /// wall-clock time spent in each InterestFilter callback
+  LatencyHistogram interestFilterDispatchTime;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const FaceMetrics& metrics);
+
+} // namespace ndn
+
+#endif // NDN_FACE_METRICS_HPP
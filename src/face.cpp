@@ -65,13 +65,40 @@ Face::expressInterest(const Interest& interest, const OnData& onData, const OnTi
   NS_LOG_INFO (">> Interest: " << interest.getName());
 
   shared_ptr<Interest> interestToExpress = make_shared<Interest>(interest);
-  m_impl->m_scheduler.scheduleEvent(time::seconds(0), [=] {
+  m_impl->dispatch(interestToExpress->wireEncode().size(), 1, [=] {
       m_impl->asyncExpressInterest(interestToExpress, onData, onTimeout);
     });
 
   return reinterpret_cast<const PendingInterestId*>(interestToExpress.get());
 }
 
+std::vector<const PendingInterestId*>
+Face::expressInterests(const std::vector<Interest>& interests,
+                       const OnData& onData, const OnTimeout& onTimeout)
+{
+  std::vector<shared_ptr<Interest>> interestsToExpress;
+  std::vector<const PendingInterestId*> ids;
+  size_t nBytes = 0;
+  interestsToExpress.reserve(interests.size());
+  ids.reserve(interests.size());
+
+  for (const Interest& interest : interests) {
+    NS_LOG_INFO (">> Interest: " << interest.getName());
+
+    interestsToExpress.push_back(make_shared<Interest>(interest));
+    ids.push_back(reinterpret_cast<const PendingInterestId*>(interestsToExpress.back().get()));
+    nBytes += interestsToExpress.back()->wireEncode().size();
+  }
+
+  m_impl->dispatch(nBytes, interestsToExpress.size(), [=] {
+      for (const auto& interestToExpress : interestsToExpress) {
+        m_impl->asyncExpressInterest(interestToExpress, onData, onTimeout);
+      }
+    });
+
+  return ids;
+}
+
 const PendingInterestId*
 Face::expressInterest(const Name& name,
                       const Interest& tmpl,
@@ -97,11 +124,102 @@ Face::put(const Data& data)
     dataPtr = make_shared<Data>(data);
   }
 
-  m_impl->m_scheduler.scheduleEvent(time::seconds(0), [=] {
+  m_impl->dispatch(dataPtr->wireEncode().size(), 1, [=] {
       m_impl->asyncPutData(dataPtr);
     });
 }
 
+void
+Face::put(const std::vector<Data>& data)
+{
+  std::vector<shared_ptr<const Data>> dataPtrs;
+  size_t nBytes = 0;
+  dataPtrs.reserve(data.size());
+
+  for (const Data& item : data) {
+    NS_LOG_INFO (">> Data: " << item.getName());
+
+    try {
+      dataPtrs.push_back(item.shared_from_this());
+    }
+    catch (const bad_weak_ptr& e) {
+      dataPtrs.push_back(make_shared<Data>(item));
+    }
+    nBytes += dataPtrs.back()->wireEncode().size();
+  }
+
+  m_impl->dispatch(nBytes, dataPtrs.size(), [=] {
+      for (const auto& dataPtr : dataPtrs) {
+        m_impl->asyncPutData(dataPtr);
+      }
+    });
+}
+
+const PendingInterestId*
+Face::submitInterest(const Interest& interest, const OnData& onData, const OnTimeout& onTimeout,
+                     const Executor& executor)
+{
+  // clones, so that the face thread never shares a Core with an object the caller can access
+  shared_ptr<Interest> interestToSubmit = make_shared<Interest>(interest.clone());
+  if (interestToSubmit->hasNonce()) {
+    interestToSubmit->wireEncode();
+  }
+
+  Impl::Submission submission;
+  submission.interest = interestToSubmit;
+  submission.onData = onData;
+  submission.onTimeout = onTimeout;
+  if (executor && onData) {
+    submission.onData = [executor, onData] (const Interest& interest, Data& data) {
+      shared_ptr<const Interest> interestCopy = make_shared<Interest>(interest.clone());
+      shared_ptr<Data> dataCopy = make_shared<Data>(data.clone());
+      executor([=] { onData(*interestCopy, *dataCopy); });
+    };
+  }
+  if (executor && onTimeout) {
+    submission.onTimeout = [executor, onTimeout] (const Interest& interest) {
+      shared_ptr<const Interest> interestCopy = make_shared<Interest>(interest.clone());
+      executor([=] { onTimeout(*interestCopy); });
+    };
+  }
+  m_impl->submit(std::move(submission));
+
+  return reinterpret_cast<const PendingInterestId*>(interestToSubmit.get());
+}
+
+void
+Face::submitData(const Data& data)
+{
+  // a clone, so that the face thread never shares a Core with an object the caller can access
+  shared_ptr<Data> dataToSubmit = make_shared<Data>(data.clone());
+  dataToSubmit->wireEncode();
+
+  Impl::Submission submission;
+  submission.data = dataToSubmit;
+  m_impl->submit(std::move(submission));
+}
+
+size_t
+Face::processSubmissions(size_t maxBatchSize)
+{
+  return m_impl->processSubmissions(maxBatchSize);
+}
+
+void
+Face::setSubmissionPolling(const time::nanoseconds& interval, size_t maxBatchSize)
+{
+  m_impl->m_submissionPollEvent.cancel();
+  m_impl->m_submissionPollInterval = interval;
+  m_impl->m_submissionPollBatchSize = maxBatchSize;
+
+  bool isPolling = interval > time::nanoseconds::zero();
+  m_impl->m_isSubmissionPolling = isPolling;
+  m_impl->m_isSubmissionPollScheduled = isPolling;
+  if (isPolling) {
+    m_impl->scheduleSubmissionPoll();
+  }
+}
+
 void
 Face::removePendingInterest(const PendingInterestId* pendingInterestId)
 {
@@ -111,6 +229,15 @@ Face::removePendingInterest(const PendingInterestId* pendingInterestId)
                                     });
 }
 
+void
+Face::removeAllPendingInterests(const Name& prefix)
+{
+  m_impl->m_scheduler.scheduleEvent(time::seconds(0),
+                                    [=] {
+                                      m_impl->asyncRemoveAllPendingInterests(prefix);
+                                    });
+}
+
 size_t
 Face::getNPendingInterests() const
 {
@@ -309,10 +436,75 @@ Face::processEvents(const time::milliseconds& timeout/* = time::milliseconds::ze
 {
 }
 
+void
+Face::setDirectDelivery(bool isEnabled)
+{
+  m_impl->m_isDirectDelivery = isEnabled;
+}
+
+bool
+Face::isDirectDelivery() const
+{
+  return m_impl->m_isDirectDelivery;
+}
+
+FaceMetrics
+Face::getMetrics() const
+{
+  return m_impl->m_metrics;
+}
+
+void
+Face::resetMetrics()
+{
+  m_impl->m_metrics = FaceMetrics();
+}
+
+void
+Face::setMetricsDumpCallback(const time::nanoseconds& interval,
+                             const function<void(const FaceMetrics&)>& callback)
+{
+  m_impl->m_metricsDumpEvent.cancel();
+  m_impl->m_metricsDumpInterval = interval;
+  m_impl->m_metricsDumpCallback = callback;
+
+  if (callback && interval > time::nanoseconds::zero()) {
+    m_impl->scheduleMetricsDump();
+  }
+}
+
+void
+Face::setSendWatermarks(size_t lowWatermark, size_t highWatermark)
+{
+  if (highWatermark != 0 && lowWatermark > highWatermark) {
+    BOOST_THROW_EXCEPTION(Error("Low watermark must not exceed high watermark"));
+  }
+  m_impl->m_sendQueueMonitor.setWatermarks(lowWatermark, highWatermark);
+}
+
+bool
+Face::isWritable() const
+{
+  return m_impl->m_sendQueueMonitor.isWritable();
+}
+
+void
+Face::setInterestAggregation(bool isEnabled)
+{
+  m_impl->m_isInterestAggregation = isEnabled;
+}
+
+bool
+Face::isInterestAggregation() const
+{
+  return m_impl->m_isInterestAggregation;
+}
+
 void
 Face::shutdown()
 {
   m_impl->m_scheduler.scheduleEvent(time::seconds(0), [=] {
+      m_impl->m_metrics.nCancelledInterests += m_impl->m_pendingInterestTable.size();
       m_impl->m_pendingInterestTable.clear();
       m_impl->m_registeredPrefixTable.clear();
 
@@ -28,7 +28,9 @@
 #include "interest.hpp"
 #include "interest-filter.hpp"
 #include "data.hpp"
+#include "face-metrics.hpp"
 #include "security/signing-info.hpp"
+#include "util/signal.hpp"
 
 #define NDN_FACE_KEEP_DEPRECATED_REGISTRATION_SIGNING
 
@@ -183,6 +185,23 @@ public: // consumer
                   const Interest& tmpl,
                   const OnData& onData, const OnTimeout& onTimeout = OnTimeout());
 
+  /**
+   * @brief Express a batch of Interests that share the same callbacks
+   *
+   * Unlike calling expressInterest for each Interest, the whole batch is handed to the
+   * forwarder by a single scheduler event, which makes sending a window of Interests cheaper.
+   *
+   * @param interests Interests to be expressed, in order
+   * @param onData    Callback to be called when a matching data packet is received
+   * @param onTimeout (optional) A function object to call if an interest times out
+   *
+   * @return pending interest IDs in the order of @p interests, which can be used with
+   *         removePendingInterest
+   */
+  std::vector<const PendingInterestId*>
+  expressInterests(const std::vector<Interest>& interests,
+                   const OnData& onData, const OnTimeout& onTimeout = OnTimeout());
+
   /**
    * @brief Cancel previously expressed Interest
    *
@@ -191,12 +210,43 @@ public: // consumer
   void
   removePendingInterest(const PendingInterestId* pendingInterestId);
 
+  /**
+   * @brief Cancel all previously expressed Interests under a name prefix
+   *
+   * Neither Data nor timeout callbacks will be invoked for the cancelled Interests.
+   *
+   * @param prefix Interests whose name starts with @p prefix are cancelled;
+   *               the default empty prefix cancels every pending Interest
+   */
+  void
+  removeAllPendingInterests(const Name& prefix = Name());
+
   /**
    * @brief Get number of pending Interests
    */
   size_t
   getNPendingInterests() const;
 
+  /**
+   * @brief Enable or disable aggregation of similar Interests
+   *
+   * When enabled, an Interest with the same Name and Selectors as an Interest already sent to
+   * the forwarder and still pending is not sent again.  Both stay pending on this face with
+   * their own callbacks and lifetimes, and the Data returned for the first one satisfies all
+   * of them.  If the sent Interest times out or is removed before Data arrives, the earliest
+   * remaining similar Interest is sent in its place.
+   *
+   * Aggregation is disabled by default.
+   */
+  void
+  setInterestAggregation(bool isEnabled);
+
+  /**
+   * @return whether aggregation of similar Interests is enabled
+   */
+  bool
+  isInterestAggregation() const;
+
 public: // producer
   /**
    * @brief Set InterestFilter to dispatch incoming matching interest to onInterest
@@ -515,13 +565,81 @@ public: // producer
    * @param data Data packet to publish.  It is highly recommended to use Data packet that
    *             was created using make_shared<Data>(...).  Otherwise, put() will make an
    *             extra copy of the Data packet to ensure validity of published Data until
-   *             asynchronous put() operation finishes.
+   *             asynchronous put() operation finishes.  The copy shares the packet fields
+   *             and wire encoding with @p data, so its cost does not depend on packet size.
    *
    * @throws Error when Data size exceeds maximum limit (MAX_NDN_PACKET_SIZE)
    */
   void
   put(const Data& data);
 
+  /**
+   * @brief Publish a batch of Data packets
+   *
+   * Unlike calling put for each Data, the whole batch is handed to the forwarder by a
+   * single scheduler event.  As with put(const Data&), Data packets that were not created
+   * with make_shared<Data>(...) are copied, which shares their fields and wire encoding.
+   *
+   * @param data Data packets to publish, in order
+   */
+  void
+  put(const std::vector<Data>& data);
+
+public: // thread-safe submission
+  /**
+   * @brief Function that runs a task on the thread it belongs to, e.g., by posting the task
+   *        to the io_service of that thread
+   */
+  typedef function<void(const function<void()>& task)> Executor;
+
+  /**
+   * @brief Express an Interest from any thread
+   *
+   * The Interest is cloned and, if it carries a nonce, encoded on the calling thread, then
+   * queued without locking.  The Interest is expressed when the face thread processes the
+   * queue with processSubmissions, possibly through setSubmissionPolling.  The default nonce
+   * generator is not thread-safe, so an Interest without a nonce is encoded on the face thread.
+   *
+   * @param executor if set, @p onData and @p onTimeout are run through it, e.g., on the
+   *                 submitting thread, with clones of the packets; otherwise they are invoked
+   *                 on the face thread
+   * @return id of the Interest, usable on the face thread once the Interest is expressed
+   */
+  const PendingInterestId*
+  submitInterest(const Interest& interest, const OnData& onData, const OnTimeout& onTimeout,
+                 const Executor& executor = Executor());
+
+  /**
+   * @brief Publish a Data packet from any thread
+   *
+   * The Data is cloned and encoded on the calling thread, then queued without locking.  It is
+   * put when the face thread processes the queue with processSubmissions.
+   *
+   * @throws tlv::Error if @p data is not signed, as encoding fails
+   */
+  void
+  submitData(const Data& data);
+
+  /**
+   * @brief Express and put the packets submitted from other threads; must be called from the
+   *        face thread
+   * @param maxBatchSize maximum number of packets processed by this call
+   * @return number of packets processed
+   */
+  size_t
+  processSubmissions(size_t maxBatchSize = std::numeric_limits<size_t>::max());
+
+  /**
+   * @brief Process the submitted packets from a scheduler event every @p interval
+   *
+   * Each event processes at most @p maxBatchSize packets.  Polling stops once the queue is
+   * empty, so that it does not keep Simulator::Run from returning, and the next submission
+   * starts it again.  A non-positive interval disables polling.
+   */
+  void
+  setSubmissionPolling(const time::nanoseconds& interval,
+                       size_t maxBatchSize = std::numeric_limits<size_t>::max());
+
 public: // IO routine
   /**
    * @brief Noop (kept for compatibility)
@@ -530,6 +648,83 @@ public: // IO routine
   processEvents(const time::milliseconds& timeout = time::milliseconds::zero(),
                 bool keepThread = false);
 
+  /**
+   * @brief Get a snapshot of the packet counters and latency histograms of this face
+   *
+   * Counters are updated by the simulation thread without synchronization, and the
+   * snapshot is a plain copy taken on that thread.
+   */
+  FaceMetrics
+  getMetrics() const;
+
+  /**
+   * @brief Reset all counters and histograms to zero
+   */
+  void
+  resetMetrics();
+
+  /**
+   * @brief Invoke @p callback with a snapshot of the metrics every @p interval
+   *
+   * Replaces the previous callback.  An empty callback or a non-positive interval stops the
+   * periodic dump.  For example, to print the metrics of a face every second:
+   * @code
+   * face.setMetricsDumpCallback(time::seconds(1),
+   *                             [] (const FaceMetrics& metrics) { std::cout << metrics; });
+   * @endcode
+   */
+  void
+  setMetricsDumpCallback(const time::nanoseconds& interval,
+                         const function<void(const FaceMetrics&)>& callback);
+
+  /**
+   * @brief Enable or disable direct delivery of packets
+   *
+   * By default, every Interest and Data crosses the simulator event queue through a
+   * zero-delay event, both when the application expresses or puts it and when the forwarder
+   * delivers it to the application.  With direct delivery, these packets are processed
+   * synchronously, unless any face of the simulation is already processing a packet
+   * (e.g., expressInterest called from an onData callback, or a producer on the same node
+   * answering a directly delivered Interest), in which case the zero-delay event is still
+   * used so that neither callbacks nor the forwarder are re-entered.
+   *
+   * Callbacks are then invoked from within the forwarder, so the Face must not be destroyed
+   * from its own callbacks while direct delivery is enabled.
+   *
+   * @note Warning: Experimental API, which may change or disappear in the future.  The
+   *       wall-clock gain over zero-delay events has not been measured on a full simulation.
+   */
+  void
+  setDirectDelivery(bool isEnabled);
+
+  /**
+   * @return whether direct delivery of packets is enabled
+   */
+  bool
+  isDirectDelivery() const;
+
+  /**
+   * @brief Set the watermarks on the bytes of Interests and Data waiting to be sent
+   *
+   * Packets expressed or put while direct delivery cannot be used wait in the simulator
+   * event queue.  When their total wire size exceeds @p highWatermark, the face becomes
+   * unwritable and emits onUnwritable; once it drops to @p lowWatermark, the face becomes
+   * writable again and emits onWritable.  Packets are never dropped: an application that
+   * keeps sending while the face is unwritable only makes the queue longer.
+   *
+   * @param lowWatermark must not exceed @p highWatermark
+   * @param highWatermark zero (the default) disables the watermarks
+   */
+  void
+  setSendWatermarks(size_t lowWatermark, size_t highWatermark);
+
+  /**
+   * @return whether the bytes waiting to be sent are below the high watermark, or have
+   *         dropped to the low watermark since they last exceeded it
+   */
+  bool
+  isWritable() const;
+
   /**
    * @brief Shutdown face operations
    *
@@ -550,6 +745,19 @@ public: // IO routine
     return *static_cast<boost::asio::io_service*>(nullptr);
   }
 
+public: // signals
+  /**
+   * @brief Emitted when the face becomes writable again
+   * @sa setSendWatermarks
+   */
+  util::Signal<Face> onWritable;
+
+  /**
+   * @brief Emitted when the bytes waiting to be sent exceed the high watermark
+   * @sa setSendWatermarks
+   */
+  util::Signal<Face> onUnwritable;
+
 private:
   void
   construct();
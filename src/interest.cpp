@@ -24,6 +24,8 @@
 #include "util/crypto.hpp"
 #include "data.hpp"
 
+#include <algorithm>
+
 namespace ndn {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Interest>));
@@ -33,56 +35,84 @@ BOOST_CONCEPT_ASSERT((WireDecodable<Interest>));
 static_assert(std::is_base_of<tlv::Error, Interest::Error>::value,
               "Interest::Error must inherit from tlv::Error");
 
+Interest::Core::Core()
+  : interestLifetime(time::milliseconds::min())
+  , selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX)
+  , hasDecodedDelegations(false)
+  , nWireBufferRefs(0)
+  , pendingDecode(0)
+{
+}
+
 Interest::Interest()
-  : m_interestLifetime(time::milliseconds::min())
-  , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX)
+  : m_core(make_shared<Core>())
 {
 }
 
 Interest::Interest(const Name& name)
-  : m_name(name)
-  , m_interestLifetime(time::milliseconds::min())
-  , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX)
+  : m_core(make_shared<Core>())
 {
+  m_core->name = name;
 }
 
 Interest::Interest(const Name& name, const time::milliseconds& interestLifetime)
-  : m_name(name)
-  , m_interestLifetime(interestLifetime)
-  , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX)
+  : m_core(make_shared<Core>())
 {
+  m_core->name = name;
+  m_core->interestLifetime = interestLifetime;
 }
 
 Interest::Interest(const Block& wire)
+  : m_core(make_shared<Core>())
 {
   wireDecode(wire);
 }
 
+Interest::Interest(const Interest& other)
+  : TagHost(other)
+  , enable_shared_from_this<Interest>(other)
+  , m_core(other.shareCore())
+  , m_localControlHeader(other.m_localControlHeader)
+{
+}
+
+Interest&
+Interest::operator=(const Interest& other)
+{
+  if (this != &other) {
+    TagHost::operator=(other);
+    m_core = other.shareCore();
+    m_localControlHeader = other.m_localControlHeader;
+  }
+  return *this;
+}
+
 uint32_t
 Interest::getNonce() const
 {
-  if (!m_nonce.hasWire())
+  if (!m_core->nonce.hasWire())
     const_cast<Interest*>(this)->setNonce(random::generateWord32());
 
-  if (m_nonce.value_size() == sizeof(uint32_t))
-    return *reinterpret_cast<const uint32_t*>(m_nonce.value());
+  if (m_core->nonce.value_size() == sizeof(uint32_t))
+    return *reinterpret_cast<const uint32_t*>(m_core->nonce.value());
   else {
     // for compatibility reasons.  Should be removed eventually
-    return readNonNegativeInteger(m_nonce);
+    return readNonNegativeInteger(m_core->nonce);
   }
 }
 
 Interest&
 Interest::setNonce(uint32_t nonce)
 {
-  if (m_wire.hasWire() && m_nonce.value_size() == sizeof(uint32_t)) {
-    std::memcpy(const_cast<uint8_t*>(m_nonce.value()), &nonce, sizeof(nonce));
+  // the wire can be updated in place only if no copy of this Interest refers to it
+  if (m_core.unique() && m_core->wire.hasWire() && m_core->nonce.value_size() == sizeof(uint32_t)) {
+    std::memcpy(const_cast<uint8_t*>(m_core->nonce.value()), &nonce, sizeof(nonce));
   }
   else {
-    m_nonce = makeBinaryBlock(tlv::Nonce,
-                              reinterpret_cast<const uint8_t*>(&nonce),
-                              sizeof(nonce));
-    m_wire.reset();
+    resetWire();
+    m_core->nonce = makeBinaryBlock(tlv::Nonce,
+                                    reinterpret_cast<const uint8_t*>(&nonce),
+                                    sizeof(nonce));
   }
   return *this;
 }
@@ -104,25 +134,25 @@ Interest::refreshNonce()
 bool
 Interest::matchesName(const Name& name) const
 {
-  if (name.size() < m_name.size())
+  if (name.size() < m_core->name.size())
     return false;
 
-  if (!m_name.isPrefixOf(name))
+  if (!m_core->name.isPrefixOf(name))
     return false;
 
   if (getMinSuffixComponents() >= 0 &&
       // name must include implicit digest
-      !(name.size() - m_name.size() >= static_cast<size_t>(getMinSuffixComponents())))
+      !(name.size() - m_core->name.size() >= static_cast<size_t>(getMinSuffixComponents())))
     return false;
 
   if (getMaxSuffixComponents() >= 0 &&
       // name must include implicit digest
-      !(name.size() - m_name.size() <= static_cast<size_t>(getMaxSuffixComponents())))
+      !(name.size() - m_core->name.size() <= static_cast<size_t>(getMaxSuffixComponents())))
     return false;
 
   if (!getExclude().empty() &&
-      name.size() > m_name.size() &&
-      getExclude().isExcluded(name[m_name.size()]))
+      name.size() > m_core->name.size() &&
+      getExclude().isExcluded(name[m_core->name.size()]))
     return false;
 
   return true;
@@ -131,7 +161,7 @@ Interest::matchesName(const Name& name) const
 bool
 Interest::matchesData(const Data& data) const
 {
-  size_t interestNameLength = m_name.size();
+  size_t interestNameLength = m_core->name.size();
   const Name& dataName = data.getName();
   size_t fullNameLength = dataName.size() + 1;
 
@@ -150,8 +180,8 @@ Interest::matchesData(const Data& data) const
 
   // check prefix
   if (interestNameLength == fullNameLength) {
-    if (m_name.get(-1).isImplicitSha256Digest()) {
-      if (m_name != data.getFullName())
+    if (m_core->name.get(-1).isImplicitSha256Digest()) {
+      if (m_core->name != data.getFullName())
         return false;
     }
     else {
@@ -162,7 +192,7 @@ Interest::matchesData(const Data& data) const
   }
   else {
     // Interest Name is a strict prefix of Data full Name
-    if (!m_name.isPrefixOf(dataName))
+    if (!m_core->name.isPrefixOf(dataName))
       return false;
   }
 
@@ -239,9 +269,9 @@ Interest::wireEncode(EncodingImpl<TAG>& encoder) const
     if (hasSelectedDelegation()) {
       totalLength += prependNonNegativeIntegerBlock(encoder,
                                                     tlv::SelectedDelegation,
-                                                    m_selectedDelegationIndex);
+                                                    m_core->selectedDelegationIndex);
     }
-    totalLength += encoder.prependBlock(m_link);
+    totalLength += encoder.prependBlock(m_core->link);
   }
   else {
     BOOST_ASSERT(!hasSelectedDelegation());
@@ -258,7 +288,7 @@ Interest::wireEncode(EncodingImpl<TAG>& encoder) const
 
   // Nonce
   getNonce(); // to ensure that Nonce is properly set
-  totalLength += encoder.prependBlock(m_nonce);
+  totalLength += encoder.prependBlock(m_core->nonce);
 
   // Selectors
   if (hasSelectors())
@@ -283,26 +313,45 @@ Interest::wireEncode<encoding::EstimatorTag>(EncodingImpl<encoding::EstimatorTag
 const Block&
 Interest::wireEncode() const
 {
-  if (m_wire.hasWire())
-    return m_wire;
+  if (m_core->wire.hasWire())
+    return m_core->wire;
+  BOOST_ASSERT(m_core.unique());
 
   EncodingEstimator estimator;
   size_t estimatedSize = wireEncode(estimator);
 
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
+  {
+    EncodingBuffer buffer(estimatedSize, 0);
+    wireEncode(buffer);
 
-  // to ensure that Nonce block points to the right memory location
-  const_cast<Interest*>(this)->wireDecode(buffer.block());
+    // to ensure that Nonce block points to the right memory location;
+    // a core without wire encoding is never shared, so this updates only this Interest
+    decodeCore(buffer.block());
+  }
+  // all fields were just encoded from their decoded form, nothing to decode lazily
+  m_core->pendingDecode = 0;
+  // the buffer is now referenced only by blocks within the core
+  m_core->nWireBufferRefs = m_core->wire.getBuffer().use_count() - 1;
 
-  return m_wire;
+  return m_core->wire;
 }
 
 void
 Interest::wireDecode(const Block& wire)
 {
-  m_wire = wire;
-  m_wire.parse();
+  if (!m_core.unique()) {
+    // other copies keep their current value
+    m_core = make_shared<Core>();
+  }
+  decodeCore(wire);
+}
+
+void
+Interest::decodeCore(const Block& wire) const
+{
+  m_core->wire = wire;
+  m_core->wire.parse();
+  m_core->nWireBufferRefs = 0;
 
   // Interest ::= INTEREST-TYPE TLV-LENGTH
   //                Name
@@ -313,72 +362,152 @@ Interest::wireDecode(const Block& wire)
   //                SelectedDelegation?
   //                PDRMStrategySelectors?
 
-  if (m_wire.type() != tlv::Interest)
+  if (m_core->wire.type() != tlv::Interest)
     BOOST_THROW_EXCEPTION(Error("Unexpected TLV number when decoding Interest"));
 
   // Name
-  m_name.wireDecode(m_wire.get(tlv::Name));
+  m_core->name.wireDecode(m_core->wire.get(tlv::Name));
 
-  // Selectors
-  Block::element_const_iterator val = m_wire.find(tlv::Selectors);
-  if (val != m_wire.elements_end())
-    {
-      m_selectors.wireDecode(*val);
-    }
-  else
-    m_selectors = Selectors();
+  // Selectors and PDRMStrategySelectors are decoded on first access, but checked now
+  Block::element_const_iterator val = m_core->wire.find(tlv::Selectors);
+  if (val != m_core->wire.elements_end())
+    Selectors::validate(*val);
+  val = m_core->wire.find(tlv::PDRMStrategySelectors);
+  if (val != m_core->wire.elements_end())
+    PDRMStrategySelectors::validate(*val);
+  m_core->pendingDecode = PENDING_SELECTORS | PENDING_PDRM_STRATEGY_SELECTORS;
 
   // Nonce
-  m_nonce = m_wire.get(tlv::Nonce);
+  m_core->nonce = m_core->wire.get(tlv::Nonce);
 
   // InterestLifetime
-  val = m_wire.find(tlv::InterestLifetime);
-  if (val != m_wire.elements_end())
+  val = m_core->wire.find(tlv::InterestLifetime);
+  if (val != m_core->wire.elements_end())
     {
-      m_interestLifetime = time::milliseconds(readNonNegativeInteger(*val));
+      m_core->interestLifetime = time::milliseconds(readNonNegativeInteger(*val));
     }
   else
     {
-      m_interestLifetime = DEFAULT_INTEREST_LIFETIME;
+      m_core->interestLifetime = DEFAULT_INTEREST_LIFETIME;
     }
 
   // Link object
-  val = m_wire.find(tlv::Data);
-  if (val != m_wire.elements_end())
+  val = m_core->wire.find(tlv::Data);
+  if (val != m_core->wire.elements_end())
+    {
+      m_core->link = (*val);
+    }
+  else
     {
-      m_link = (*val);
+      m_core->link.reset();
     }
+  m_core->delegations.clear();
+  m_core->hasDecodedDelegations = false;
 
   // SelectedDelegation
-  val = m_wire.find(tlv::SelectedDelegation);
-  if (val != m_wire.elements_end()) {
-    if (!this->hasLink()) {
+  //
+  // The index is checked against the number of delegations only when the selected
+  // delegation is retrieved, so that decoding does not need to parse the Link content.
+  val = m_core->wire.find(tlv::SelectedDelegation);
+  if (val != m_core->wire.elements_end()) {
+    if (!m_core->link.hasWire()) {
       BOOST_THROW_EXCEPTION(Error("Interest contains selectedDelegation, but no LINK object"));
     }
     uint64_t selectedDelegation = readNonNegativeInteger(*val);
-    if (selectedDelegation < uint64_t(Link::countDelegationsFromWire(m_link))) {
-      m_selectedDelegationIndex = static_cast<size_t>(selectedDelegation);
-    }
-    else {
+    if (selectedDelegation >= INVALID_SELECTED_DELEGATION_INDEX) {
       BOOST_THROW_EXCEPTION(Error("Invalid selected delegation index when decoding Interest"));
     }
+    m_core->selectedDelegationIndex = static_cast<size_t>(selectedDelegation);
+  }
+  else {
+    m_core->selectedDelegationIndex = INVALID_SELECTED_DELEGATION_INDEX;
   }
+}
 
-  // Selectors
-  val = m_wire.find(tlv::PDRMStrategySelectors);
-  if (val != m_wire.elements_end())
+void
+Interest::decodePendingSelectors() const
+{
+  BOOST_ASSERT(m_core->wire.hasWire());
+  BOOST_ASSERT(m_core.unique());
+
+  Block::element_const_iterator val = m_core->wire.find(tlv::Selectors);
+  if (val != m_core->wire.elements_end())
+    {
+      m_core->selectors.wireDecode(*val);
+    }
+  else
+    m_core->selectors = Selectors();
+
+  m_core->pendingDecode &= ~PENDING_SELECTORS;
+}
+
+void
+Interest::decodePendingPDRMStrategySelectors() const
+{
+  BOOST_ASSERT(m_core->wire.hasWire());
+  BOOST_ASSERT(m_core.unique());
+
+  Block::element_const_iterator val = m_core->wire.find(tlv::PDRMStrategySelectors);
+  if (val != m_core->wire.elements_end())
     {
-      m_PDRMStrategySelectors.wireDecode(*val);
+      m_core->pdrmStrategySelectors.wireDecode(*val);
     }
   else
-    m_PDRMStrategySelectors = PDRMStrategySelectors();
+    m_core->pdrmStrategySelectors = PDRMStrategySelectors();
+
+  m_core->pendingDecode &= ~PENDING_PDRM_STRATEGY_SELECTORS;
+}
+
+Interest
+Interest::clone() const
+{
+  Interest copy(*this);
+  copy.m_core = make_shared<Core>(*m_core);
+  return copy;
+}
+
+void
+Interest::detach()
+{
+  if (!m_core.unique()) {
+    m_core = make_shared<Core>(*m_core);
+  }
+}
+
+shared_ptr<Interest::Core>
+Interest::shareCore() const
+{
+  if (!m_core->wire.hasWire() ||
+      (m_core->link.hasWire() && !m_core->hasDecodedDelegations)) {
+    // wireEncode or getDelegationNames would write into the core later
+    return make_shared<Core>(*m_core);
+  }
+
+  // a core that is already shared has nothing pending
+  if (m_core->pendingDecode & PENDING_SELECTORS)
+    decodePendingSelectors();
+  if (m_core->pendingDecode & PENDING_PDRM_STRATEGY_SELECTORS)
+    decodePendingPDRMStrategySelectors();
+  return m_core;
+}
+
+void
+Interest::resetWire()
+{
+  detach();
+
+  if (m_core->pendingDecode & PENDING_SELECTORS)
+    decodePendingSelectors();
+  if (m_core->pendingDecode & PENDING_PDRM_STRATEGY_SELECTORS)
+    decodePendingPDRMStrategySelectors();
 
+  m_core->wire.reset();
 }
 
 bool
 Interest::hasLink() const
 {
-  if (m_link.hasWire())
+  if (m_core->link.hasWire())
     return true;
   return false;
 }
@@ -388,7 +517,7 @@ Interest::getLink() const
 {
   if (hasLink())
     {
-      return Link(m_link);
+      return Link(m_core->link);
     }
   BOOST_THROW_EXCEPTION(Error("There is no encapsulated link object"));
 }
@@ -396,26 +525,28 @@ Interest::getLink() const
 void
 Interest::setLink(const Block& link)
 {
-  m_link = link;
   if (!link.hasWire()) {
     BOOST_THROW_EXCEPTION(Error("The given link does not have a wire format"));
   }
-  m_wire.reset();
+  resetWire();
+  m_core->link = link;
+  this->resetDelegationNames();
   this->unsetSelectedDelegation();
 }
 
 void
 Interest::unsetLink()
 {
-  m_link.reset();
-  m_wire.reset();
+  resetWire();
+  m_core->link.reset();
+  this->resetDelegationNames();
   this->unsetSelectedDelegation();
 }
 
 bool
 Interest::hasSelectedDelegation() const
 {
-  if (m_selectedDelegationIndex != INVALID_SELECTED_DELEGATION_INDEX)
+  if (m_core->selectedDelegationIndex != INVALID_SELECTED_DELEGATION_INDEX)
     {
       return true;
     }
@@ -428,37 +559,109 @@ Interest::getSelectedDelegation() const
   if (!hasSelectedDelegation()) {
     BOOST_THROW_EXCEPTION(Error("There is no encapsulated selected delegation"));
   }
-  return std::get<1>(Link::getDelegationFromWire(m_link, m_selectedDelegationIndex));
+  const std::vector<Name>& delegations = getDelegationNames();
+  if (m_core->selectedDelegationIndex >= delegations.size()) {
+    BOOST_THROW_EXCEPTION(Error("Invalid selected delegation index"));
+  }
+  return delegations[m_core->selectedDelegationIndex];
 }
 
 void
 Interest::setSelectedDelegation(const Name& delegationName)
 {
-  size_t delegationIndex = Link::findDelegationFromWire(m_link, delegationName);
-  if (delegationIndex != INVALID_SELECTED_DELEGATION_INDEX) {
-    m_selectedDelegationIndex = delegationIndex;
+  if (!hasLink()) {
+    BOOST_THROW_EXCEPTION(Error("There is no encapsulated link object"));
   }
-  else {
+  const std::vector<Name>& delegations = getDelegationNames();
+  auto it = std::find(delegations.begin(), delegations.end(), delegationName);
+  if (it == delegations.end()) {
     BOOST_THROW_EXCEPTION(std::invalid_argument("Invalid selected delegation name"));
   }
-  m_wire.reset();
+  selectDelegation(std::distance(delegations.begin(), it));
 }
 
 void
 Interest::setSelectedDelegation(size_t delegationIndex)
 {
-  if (delegationIndex >= Link(m_link).getDelegations().size()) {
+  if (!hasLink() || delegationIndex >= getDelegationNames().size()) {
     BOOST_THROW_EXCEPTION(Error("Invalid selected delegation index"));
   }
-  m_selectedDelegationIndex = delegationIndex;
-  m_wire.reset();
+  selectDelegation(delegationIndex);
 }
 
 void
 Interest::unsetSelectedDelegation()
 {
-  m_selectedDelegationIndex = INVALID_SELECTED_DELEGATION_INDEX;
-  m_wire.reset();
+  resetWire();
+  m_core->selectedDelegationIndex = INVALID_SELECTED_DELEGATION_INDEX;
+}
+
+void
+Interest::selectDelegation(size_t delegationIndex)
+{
+  // When the wire already carries a SelectedDelegation wide enough for the new index,
+  // and neither a copy of this Interest nor a copy of its wire (e.g. queued for sending)
+  // refers to the buffer, only that field is rewritten.
+  if (m_core.unique() && m_core->wire.hasWire() && hasSelectedDelegation() &&
+      m_core->nWireBufferRefs > 0 &&
+      m_core->wire.getBuffer().use_count() - 1 == m_core->nWireBufferRefs) {
+    Block::element_const_iterator val = m_core->wire.find(tlv::SelectedDelegation);
+    BOOST_ASSERT(val != m_core->wire.elements_end());
+    size_t width = val->value_size();
+    if (width >= sizeof(uint64_t) || (static_cast<uint64_t>(delegationIndex) >> (8 * width)) == 0) {
+      uint8_t* pos = const_cast<uint8_t*>(val->value());
+      uint64_t value = delegationIndex;
+      for (size_t i = width; i > 0; --i) {
+        pos[i - 1] = static_cast<uint8_t>(value & 0xFF);
+        value >>= 8;
+      }
+      m_core->selectedDelegationIndex = delegationIndex;
+      return;
+    }
+  }
+
+  resetWire();
+  m_core->selectedDelegationIndex = delegationIndex;
+}
+
+const std::vector<Name>&
+Interest::getDelegationNames() const
+{
+  BOOST_ASSERT(hasLink());
+
+  if (!m_core->hasDecodedDelegations) {
+    BOOST_ASSERT(m_core.unique());
+    long nWireBufferRefsBefore = m_core->wire.getBuffer().use_count();
+    const Block& link = m_core->link;
+    link.parse();
+    const Block& content = link.get(tlv::Content);
+    content.parse();
+
+    std::vector<Name> delegations;
+    delegations.reserve(content.elements_size());
+    for (const Block& delegation : content.elements()) {
+      if (delegation.type() != tlv::LinkDelegation) {
+        BOOST_THROW_EXCEPTION(Link::Error("Unexpected TLV-TYPE, expecting LinkDelegation"));
+      }
+      delegation.parse();
+      delegations.push_back(Name(delegation.get(tlv::Name)));
+    }
+
+    m_core->delegations.swap(delegations);
+    m_core->hasDecodedDelegations = true;
+    if (m_core->nWireBufferRefs > 0) {
+      // the delegation names share the buffer of the wire
+      m_core->nWireBufferRefs += m_core->wire.getBuffer().use_count() - nWireBufferRefsBefore;
+    }
+  }
+  return m_core->delegations;
+}
+
+void
+Interest::resetDelegationNames()
+{
+  m_core->delegations.clear();
+  m_core->hasDecodedDelegations = false;
 }
 
 std::ostream&
@@ -42,6 +42,9 @@ class Data;
 const time::milliseconds DEFAULT_INTEREST_LIFETIME = time::milliseconds(4000);
 
 /** @brief represents an Interest packet
+ *
+ *  Copies of an Interest share their decoded fields and wire encoding until one of them is
+ *  modified.  The shared state is never written, so copies can be used on different threads.
  */
 class Interest : public TagHost, public enable_shared_from_this<Interest>
 {
@@ -85,6 +88,31 @@ public:
   explicit
   Interest(const Block& wire);
 
+  /** @brief Create a copy that shares the decoded fields and wire encoding of @p other
+   *
+   *  Fields of @p other whose decoding has been deferred are decoded first, so that the
+   *  shared state is complete.  An Interest without wire encoding is copied field by field,
+   *  because wireEncode would otherwise cache its encoding in the shared state.
+   */
+  Interest(const Interest& other);
+
+  Interest(Interest&& other) = default;
+
+  Interest&
+  operator=(const Interest& other);
+
+  Interest&
+  operator=(Interest&& other) = default;
+
+  /** @brief Create a copy that shares no state with this Interest
+   *
+   *  Unlike the copy constructor, the copy gets its own decoded fields and wire encoding;
+   *  only the immutable bytes of the encoding are shared.  This keeps an Interest handed to
+   *  another thread from contending on the reference count of the shared state.
+   */
+  Interest
+  clone() const;
+
   /**
    * @brief Fast encoding or block size estimation
    */
@@ -110,7 +138,7 @@ public:
   bool
   hasWire() const
   {
-    return m_wire.hasWire();
+    return m_core->wire.hasWire();
   }
 
   /**
@@ -216,28 +244,28 @@ public: // Name and guiders
   const Name&
   getName() const
   {
-    return m_name;
+    return m_core->name;
   }
 
   Interest&
   setName(const Name& name)
   {
-    m_name = name;
-    m_wire.reset();
+    resetWire();
+    m_core->name = name;
     return *this;
   }
 
   const time::milliseconds&
   getInterestLifetime() const
   {
-    return m_interestLifetime;
+    return m_core->interestLifetime;
   }
 
   Interest&
   setInterestLifetime(const time::milliseconds& interestLifetime)
   {
-    m_interestLifetime = interestLifetime;
-    m_wire.reset();
+    resetWire();
+    m_core->interestLifetime = interestLifetime;
     return *this;
   }
 
@@ -246,7 +274,7 @@ public: // Name and guiders
   bool
   hasNonce() const
   {
-    return m_nonce.hasWire();
+    return m_core->nonce.hasWire();
   }
 
   /** @brief Get Interest's nonce
@@ -322,104 +350,106 @@ public: // Selectors
   bool
   hasSelectors() const
   {
-    return !m_selectors.empty();
+    return !getSelectors().empty();
   }
 
   const Selectors&
   getSelectors() const
   {
-    return m_selectors;
+    if (m_core->pendingDecode & PENDING_SELECTORS)
+      decodePendingSelectors();
+    return m_core->selectors;
   }
 
   Interest&
   setSelectors(const Selectors& selectors)
   {
-    m_selectors = selectors;
-    m_wire.reset();
+    resetWire();
+    m_core->selectors = selectors;
     return *this;
   }
 
   int
   getMinSuffixComponents() const
   {
-    return m_selectors.getMinSuffixComponents();
+    return getSelectors().getMinSuffixComponents();
   }
 
   Interest&
   setMinSuffixComponents(int minSuffixComponents)
   {
-    m_selectors.setMinSuffixComponents(minSuffixComponents);
-    m_wire.reset();
+    resetWire();
+    m_core->selectors.setMinSuffixComponents(minSuffixComponents);
     return *this;
   }
 
   int
   getMaxSuffixComponents() const
   {
-    return m_selectors.getMaxSuffixComponents();
+    return getSelectors().getMaxSuffixComponents();
   }
 
   Interest&
   setMaxSuffixComponents(int maxSuffixComponents)
   {
-    m_selectors.setMaxSuffixComponents(maxSuffixComponents);
-    m_wire.reset();
+    resetWire();
+    m_core->selectors.setMaxSuffixComponents(maxSuffixComponents);
     return *this;
   }
 
   const KeyLocator&
   getPublisherPublicKeyLocator() const
   {
-    return m_selectors.getPublisherPublicKeyLocator();
+    return getSelectors().getPublisherPublicKeyLocator();
   }
 
   Interest&
   setPublisherPublicKeyLocator(const KeyLocator& keyLocator)
   {
-    m_selectors.setPublisherPublicKeyLocator(keyLocator);
-    m_wire.reset();
+    resetWire();
+    m_core->selectors.setPublisherPublicKeyLocator(keyLocator);
     return *this;
   }
 
   const Exclude&
   getExclude() const
   {
-    return m_selectors.getExclude();
+    return getSelectors().getExclude();
   }
 
   Interest&
   setExclude(const Exclude& exclude)
   {
-    m_selectors.setExclude(exclude);
-    m_wire.reset();
+    resetWire();
+    m_core->selectors.setExclude(exclude);
     return *this;
   }
 
   int
   getChildSelector() const
   {
-    return m_selectors.getChildSelector();
+    return getSelectors().getChildSelector();
   }
 
   Interest&
   setChildSelector(int childSelector)
   {
-    m_selectors.setChildSelector(childSelector);
-    m_wire.reset();
+    resetWire();
+    m_core->selectors.setChildSelector(childSelector);
     return *this;
   }
 
   int
   getMustBeFresh() const
   {
-    return m_selectors.getMustBeFresh();
+    return getSelectors().getMustBeFresh();
   }
 
   Interest&
   setMustBeFresh(bool mustBeFresh)
   {
-    m_selectors.setMustBeFresh(mustBeFresh);
-    m_wire.reset();
+    resetWire();
+    m_core->selectors.setMustBeFresh(mustBeFresh);
     return *this;
   }
 
@@ -430,132 +460,134 @@ public: // Strategy Selectors
   bool
   hasPDRMStrategySelectors() const
   {
-    return !m_PDRMStrategySelectors.empty();
+    return !getPDRMStrategySelectors().empty();
   }
 
   const PDRMStrategySelectors&
   getPDRMStrategySelectors() const
   {
-    return m_PDRMStrategySelectors;
+    if (m_core->pendingDecode & PENDING_PDRM_STRATEGY_SELECTORS)
+      decodePendingPDRMStrategySelectors();
+    return m_core->pdrmStrategySelectors;
   }
 
   Interest&
   setPDRMStrategySelectors(const PDRMStrategySelectors& PDRMStrategySelectors)
   {
-    m_PDRMStrategySelectors = PDRMStrategySelectors;
-    m_wire.reset();
+    resetWire();
+    m_core->pdrmStrategySelectors = PDRMStrategySelectors;
     return *this;
   }
 
   int32_t
   getScope() const
   {
-    return m_PDRMStrategySelectors.getScope();
+    return getPDRMStrategySelectors().getScope();
   }
 
   Interest&
   setScope(int32_t scope)
   {
-    m_PDRMStrategySelectors.setScope(scope);
-    m_wire.reset();
+    resetWire();
+    m_core->pdrmStrategySelectors.setScope(scope);
     return *this;
   }
 
   int32_t
   getNodeId() const
   {
-    return m_PDRMStrategySelectors.getNodeId();
+    return getPDRMStrategySelectors().getNodeId();
   }
 
   Interest&
   setNodeId(int32_t nodeId)
   {
-    m_PDRMStrategySelectors.setNodeId(nodeId);
-    m_wire.reset();
+    resetWire();
+    m_core->pdrmStrategySelectors.setNodeId(nodeId);
     return *this;
   }
 
   int32_t
   getHomeNetwork() const
   {
-    return m_PDRMStrategySelectors.getHomeNetwork();
+    return getPDRMStrategySelectors().getHomeNetwork();
   }
 
   Interest&
   setHomeNetwork(int32_t homeNetwork)
   {
-    m_PDRMStrategySelectors.setHomeNetwork(homeNetwork);
-    m_wire.reset();
+    resetWire();
+    m_core->pdrmStrategySelectors.setHomeNetwork(homeNetwork);
     return *this;
   }
 
   int32_t
   getPreferredLocation() const
   {
-    return m_PDRMStrategySelectors.getPreferredLocation();
+    return getPDRMStrategySelectors().getPreferredLocation();
   }
 
   Interest&
   setPreferredLocation(int32_t preferredLocation)
   {
-    m_PDRMStrategySelectors.setPreferredLocation(preferredLocation);
-    m_wire.reset();
+    resetWire();
+    m_core->pdrmStrategySelectors.setPreferredLocation(preferredLocation);
     return *this;
   }
 
   double
   getTimeSpentAtPreferredLocation() const
   {
-    return m_PDRMStrategySelectors.getTimeSpentAtPreferredLocation();
+    return getPDRMStrategySelectors().getTimeSpentAtPreferredLocation();
   }
 
   Interest&
   setTimeSpentAtPreferredLocation(double timeSpentAtPreferredLocation)
   {
-    m_PDRMStrategySelectors.setTimeSpentAtPreferredLocation(timeSpentAtPreferredLocation);
-    m_wire.reset();
+    resetWire();
+    m_core->pdrmStrategySelectors.setTimeSpentAtPreferredLocation(timeSpentAtPreferredLocation);
     return *this;
   }
 
   int32_t
   getCurrentPosition() const
   {
-    return m_PDRMStrategySelectors.getCurrentPosition();
+    return getPDRMStrategySelectors().getCurrentPosition();
   }
 
   Interest&
   setCurrentPosition(int32_t currentPosition)
   {
-    m_PDRMStrategySelectors.setCurrentPosition(currentPosition);
-    m_wire.reset();
+    resetWire();
+    m_core->pdrmStrategySelectors.setCurrentPosition(currentPosition);
     return *this;
   }
 
   double
   getAvailability() const
   {
-    return m_PDRMStrategySelectors.getAvailability();
+    return getPDRMStrategySelectors().getAvailability();
   }
 
   Interest&
   setAvailability(double availability)
   {
-    m_PDRMStrategySelectors.setAvailability(availability);
-    m_wire.reset();
+    resetWire();
+    m_core->pdrmStrategySelectors.setAvailability(availability);
     return *this;
   }
 
   bool
   getInterest() const
   {
-    return m_PDRMStrategySelectors.getInterest();
+    return getPDRMStrategySelectors().getInterest();
   }
 
   Interest&
   setInterest(bool interested)
   {
-    m_PDRMStrategySelectors.setInterest(interested);
-    m_wire.reset();
+    resetWire();
+    m_core->pdrmStrategySelectors.setInterest(interested);
     return *this;
   }
 
@@ -573,15 +605,109 @@ public: // EqualityComparable concept
   }
 
 private:
-  Name m_name;
-  Selectors m_selectors;
-  mutable Block m_nonce;
-  time::milliseconds m_interestLifetime;
-  PDRMStrategySelectors m_PDRMStrategySelectors;
-
-  mutable Block m_link;
-  size_t m_selectedDelegationIndex;
-  mutable Block m_wire;
+  struct Core;
+
+  /** @brief Decode @p wire into the core without detaching it
+   */
+  void
+  decodeCore(const Block& wire) const;
+
+  /** @brief Decode Selectors from the wire format recorded by wireDecode
+   */
+  void
+  decodePendingSelectors() const;
+
+  /** @brief Decode PDRMStrategySelectors from the wire format recorded by wireDecode
+   */
+  void
+  decodePendingPDRMStrategySelectors() const;
+
+  /** @brief Make the core private to this Interest, copying it if it is shared
+   */
+  void
+  detach();
+
+  /** @brief Get the core for a copy of this Interest
+   *
+   *  The core is returned itself once nothing is left for a const method to write into it:
+   *  pending fields are decoded first.  If the wire encoding or the delegation names have
+   *  yet to be cached, a private copy of the core is returned instead.
+   */
+  shared_ptr<Core>
+  shareCore() const;
+
+  /** @brief Get delegation names of the Link in wire order, decoding them on first call
+   *  @pre hasLink()
+   *  @throw Link::Error a delegation in the Link is malformed
+   */
+  const std::vector<Name>&
+  getDelegationNames() const;
+
+  /** @brief Forget the delegation names decoded from the current Link
+   */
+  void
+  resetDelegationNames();
+
+  /** @brief Set the selected delegation index, which has been checked against the Link
+   *
+   *  If the current wire format already has a SelectedDelegation field and its buffer is
+   *  referenced only by this Interest, the field is updated in place instead of re-encoding
+   *  the Interest.
+   */
+  void
+  selectDelegation(size_t delegationIndex);
+
+  /** @brief Detach the core and invalidate its wire format before a field is modified
+   *
+   *  Any field whose decoding has been deferred is decoded first, because its only
+   *  source is the wire format that is about to be discarded.
+   */
+  void
+  resetWire();
+
+private:
+  /** @brief Fields that are decoded on first access instead of in wireDecode
+   *
+   *  Code paths that only need the Name (e.g., InterestFilter matching) do not pay
+   *  for decoding Exclude, KeyLocator, and PDRM strategy selectors.  wireDecode still
+   *  checks these fields with Selectors::validate and PDRMStrategySelectors::validate,
+   *  so a malformed packet is rejected there and the selector getters do not throw.
+   */
+  enum PendingDecodeField : uint8_t {
+    PENDING_SELECTORS               = 1 << 0,
+    PENDING_PDRM_STRATEGY_SELECTORS = 1 << 1
+  };
+
+  /** @brief Decoded fields and wire encoding of the Interest
+   *
+   *  The core is shared between copies of an Interest, so that copying is O(1)
+   *  regardless of the packet size.  Every modifying method detaches the core first,
+   *  and const methods cache the wire encoding and lazily decoded fields only in a core
+   *  that is not shared (see shareCore), so a shared core is never written.
+   */
+  struct Core
+  {
+    Core();
+
+    Name name;
+    Selectors selectors;
+    Block nonce;
+    time::milliseconds interestLifetime;
+    PDRMStrategySelectors pdrmStrategySelectors;
+
+    Block link;
+    size_t selectedDelegationIndex;
+    /// delegation names of the Link in wire order, sharing the buffer of the Link wire
+    std::vector<Name> delegations;
+    bool hasDecodedDelegations;
+    Block wire;
+    /// references to the buffer of wire held by this core, if the buffer was allocated
+    /// by wireEncode; 0 if the buffer may be owned by someone else (e.g. after wireDecode)
+    long nWireBufferRefs;
+    uint8_t pendingDecode;
+  };
+
+  shared_ptr<Core> m_core;
 
   nfd::LocalControlHeader m_localControlHeader;
   friend class nfd::LocalControlHeader;
@@ -97,29 +97,52 @@ KeyLocator::wireEncode() const
 
 void
 KeyLocator::wireDecode(const Block& wire)
+{
+  decode(wire, this);
+}
+
+void
+KeyLocator::validate(const Block& wire)
+{
+  decode(wire, nullptr);
+}
+
+void
+KeyLocator::decode(const Block& wire, KeyLocator* keyLocator)
 {
   if (wire.type() != tlv::KeyLocator)
     BOOST_THROW_EXCEPTION(Error("Unexpected TLV type during KeyLocator decoding"));
 
-  m_wire = wire;
-  m_wire.parse();
+  if (keyLocator != nullptr)
+    keyLocator->m_wire = wire;
+  const Block& elements = keyLocator != nullptr ? keyLocator->m_wire : wire;
+  elements.parse();
 
-  if (m_wire.elements().empty()) {
-    m_type = KeyLocator_None;
+  if (elements.elements().empty()) {
+    if (keyLocator != nullptr)
+      keyLocator->m_type = KeyLocator_None;
     return;
   }
 
-  switch (m_wire.elements_begin()->type()) {
+  switch (elements.elements_begin()->type()) {
   case tlv::Name:
-    m_type = KeyLocator_Name;
-    m_name.wireDecode(*m_wire.elements_begin());
+    if (keyLocator != nullptr) {
+      keyLocator->m_type = KeyLocator_Name;
+      keyLocator->m_name.wireDecode(*elements.elements_begin());
+    }
+    else {
+      Name().wireDecode(*elements.elements_begin());
+    }
     break;
   case tlv::KeyDigest:
-    m_type = KeyLocator_KeyDigest;
-    m_keyDigest = *m_wire.elements_begin();
+    if (keyLocator != nullptr) {
+      keyLocator->m_type = KeyLocator_KeyDigest;
+      keyLocator->m_keyDigest = *elements.elements_begin();
+    }
     break;
   default:
-    m_type = KeyLocator_Unknown;
+    if (keyLocator != nullptr)
+      keyLocator->m_type = KeyLocator_Unknown;
     break;
   }
 }
@@ -90,6 +90,15 @@ public: // encode and decode
   void
   wireDecode(const Block& wire);
 
+  /** \brief check that \p wire would be accepted by wireDecode, without decoding it
+   *
+   *  \p wire is parsed in place, so that decoding a copy of it later does not parse it again.
+   *
+   *  \throw tlv::Error \p wire is malformed
+   */
+  static void
+  validate(const Block& wire);
+
 public: // attributes
   bool
   empty() const
@@ -154,6 +163,12 @@ public: // EqualityComparable concept
     return !this->operator==(other);
   }
 
+private:
+  /** \brief decode \p wire into \p keyLocator, or only check it if \p keyLocator is nullptr
+   */
+  static void
+  decode(const Block& wire, KeyLocator* keyLocator);
+
 private:
   Type m_type;
   Name m_name;
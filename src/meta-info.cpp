@@ -76,8 +76,8 @@ MetaInfo::getAppMetaInfo() const
 MetaInfo&
 MetaInfo::setAppMetaInfo(const std::list<Block>& info)
 {
-  for (std::list<Block>::const_iterator i = info.begin(); i != info.end(); ++i) {
-    if (!(128 <= i->type() && i->type() <= 252))
+  for (const Block& block : info) {
+    if (!(128 <= block.type() && block.type() <= 252))
       BOOST_THROW_EXCEPTION(Error("AppMetaInfo block has type outside the application range "
                                   "[128, 252]"));
   }
@@ -102,8 +102,7 @@ MetaInfo::addAppMetaInfo(const Block& block)
 bool
 MetaInfo::removeAppMetaInfo(uint32_t tlvType)
 {
-  for (std::list<Block>::iterator iter = m_appMetaInfo.begin();
-       iter != m_appMetaInfo.end(); ++iter) {
+  for (auto iter = m_appMetaInfo.begin(); iter != m_appMetaInfo.end(); ++iter) {
     if (iter->type() == tlvType) {
       m_wire.reset();
       m_appMetaInfo.erase(iter);
@@ -116,10 +115,9 @@ MetaInfo::removeAppMetaInfo(uint32_t tlvType)
 const Block*
 MetaInfo::findAppMetaInfo(uint32_t tlvType) const
 {
-  for (std::list<Block>::const_iterator iter = m_appMetaInfo.begin();
-       iter != m_appMetaInfo.end(); ++iter) {
-    if (iter->type() == tlvType) {
-      return &*iter;
+  for (const Block& block : m_appMetaInfo) {
+    if (block.type() == tlvType) {
+      return &block;
     }
   }
   return 0;
@@ -135,9 +133,14 @@ MetaInfo::wireEncode(EncodingImpl<TAG>& encoder) const
   //                FinalBlockId?
   //                AppMetaInfo*
 
+  // the cached encoding (e.g., the bytes in a decoded Data packet) is copied as is
+  if (m_wire.hasWire()) {
+    return encoder.prependBlock(m_wire);
+  }
+
   size_t totalLength = 0;
 
-  for (std::list<Block>::const_reverse_iterator appMetaInfoItem = m_appMetaInfo.rbegin();
+  for (auto appMetaInfoItem = m_appMetaInfo.rbegin();
        appMetaInfoItem != m_appMetaInfo.rend(); ++appMetaInfoItem) {
     totalLength += encoder.prependBlock(*appMetaInfoItem);
   }
@@ -191,8 +194,22 @@ MetaInfo::wireEncode() const
 void
 MetaInfo::wireDecode(const Block& wire)
 {
-  m_wire = wire;
-  m_wire.parse();
+  decode(wire, this);
+}
+
+void
+MetaInfo::validate(const Block& wire)
+{
+  decode(wire, nullptr);
+}
+
+void
+MetaInfo::decode(const Block& wire, MetaInfo* metaInfo)
+{
+  if (metaInfo != nullptr)
+    metaInfo->m_wire = wire;
+  const Block& elements = metaInfo != nullptr ? metaInfo->m_wire : wire;
+  elements.parse();
 
   // MetaInfo ::= META-INFO-TYPE TLV-LENGTH
   //                ContentType?
@@ -201,44 +218,46 @@ MetaInfo::wireDecode(const Block& wire)
   //                AppMetaInfo*
 
 
-  Block::element_const_iterator val = m_wire.elements_begin();
+  Block::element_const_iterator val = elements.elements_begin();
 
   // ContentType
-  if (val != m_wire.elements_end() && val->type() == tlv::ContentType) {
-    m_type = readNonNegativeInteger(*val);
+  uint32_t type = tlv::ContentType_Blob;
+  if (val != elements.elements_end() && val->type() == tlv::ContentType) {
+    type = readNonNegativeInteger(*val);
     ++val;
   }
-  else {
-    m_type = tlv::ContentType_Blob;
-  }
 
   // FreshnessPeriod
-  if (val != m_wire.elements_end() && val->type() == tlv::FreshnessPeriod) {
-    m_freshnessPeriod = time::milliseconds(readNonNegativeInteger(*val));
+  time::milliseconds freshnessPeriod = time::milliseconds::min();
+  if (val != elements.elements_end() && val->type() == tlv::FreshnessPeriod) {
+    freshnessPeriod = time::milliseconds(readNonNegativeInteger(*val));
     ++val;
   }
-  else {
-    m_freshnessPeriod = time::milliseconds::min();
-  }
 
   // FinalBlockId
-  if (val != m_wire.elements_end() && val->type() == tlv::FinalBlockId) {
-    m_finalBlockId = val->blockFromValue();
-    if (m_finalBlockId.type() != tlv::NameComponent)
+  name::Component finalBlockId;
+  if (val != elements.elements_end() && val->type() == tlv::FinalBlockId) {
+    finalBlockId = val->blockFromValue();
+    if (finalBlockId.type() != tlv::NameComponent)
       {
         /// @todo May or may not throw exception later...
-        m_finalBlockId.reset();
+        finalBlockId.reset();
       }
     ++val;
   }
   else {
-    m_finalBlockId.reset();
+    finalBlockId.reset();
   }
 
+  if (metaInfo == nullptr)
+    return;
+
+  metaInfo->m_type = type;
+  metaInfo->m_freshnessPeriod = freshnessPeriod;
+  metaInfo->m_finalBlockId = finalBlockId;
+
   // AppMetaInfo (if any)
-  for (; val != m_wire.elements().end(); ++val) {
-    m_appMetaInfo.push_back(*val);
-  }
+  metaInfo->m_appMetaInfo.assign(val, elements.elements_end());
 }
 
 std::ostream&
@@ -259,9 +278,8 @@ operator<<(std::ostream& os, const MetaInfo& info)
   }
 
   // App-defined MetaInfo items
-  for (std::list<Block>::const_iterator iter = info.getAppMetaInfo().begin();
-       iter != info.getAppMetaInfo().end(); ++iter) {
-    os << ", AppMetaInfoTlvType: " << iter->type();
+  for (const Block& block : info.getAppMetaInfo()) {
+    os << ", AppMetaInfoTlvType: " << block.type();
   }
 
   return os;
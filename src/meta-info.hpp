@@ -84,6 +84,15 @@ public:
   void
   wireDecode(const Block& wire);
 
+  /** @brief check that @p wire would be accepted by wireDecode, without decoding it
+   *
+   *  @p wire is parsed in place, so that decoding a copy of it later does not parse it again.
+   *
+   *  @throw tlv::Error @p wire is malformed
+   */
+  static void
+  validate(const Block& wire);
+
 public: // getter/setter
   uint32_t
   getType() const;
@@ -184,12 +193,19 @@ public: // EqualityComparable concept
   bool
   operator!=(const MetaInfo& other) const;
 
+private:
+  /** @brief decode @p wire into @p metaInfo, or only check it if @p metaInfo is nullptr
+   */
+  static void
+  decode(const Block& wire, MetaInfo* metaInfo);
+
 private:
   uint32_t m_type;
   time::milliseconds m_freshnessPeriod;
   name::Component m_finalBlockId;
   std::list<Block> m_appMetaInfo;
 
+  /// wire encoding, which refers to the enclosing Data buffer after wireDecode
   mutable Block m_wire;
 };
 
@@ -136,54 +136,82 @@ PDRMStrategySelectors::wireEncode() const
 void
 PDRMStrategySelectors::wireDecode(const Block& wire)
 {
-  if (wire.type() != tlv::PDRMStrategySelectors)
-    BOOST_THROW_EXCEPTION(tlv::Error("Unexpected TLV type when decoding PDRMStrategySelectors"));
+  decode(wire, this);
+}
 
-  *this = PDRMStrategySelectors();
+void
+PDRMStrategySelectors::validate(const Block& wire)
+{
+  decode(wire, nullptr);
+}
 
-  m_wire = wire;
-  m_wire.parse();
+void
+PDRMStrategySelectors::decode(const Block& wire, PDRMStrategySelectors* selectors)
+{
+  if (wire.type() != tlv::PDRMStrategySelectors)
+    BOOST_THROW_EXCEPTION(tlv::Error("Unexpected TLV type when decoding PDRMStrategySelectors"));
 
-  Block::element_const_iterator val = m_wire.find(tlv::PDRMScope);
-  if (val != m_wire.elements_end()) {
-    m_scope = readNonNegativeInteger(*val);
+  if (selectors != nullptr) {
+    *selectors = PDRMStrategySelectors();
+    selectors->m_wire = wire;
   }
-
-  val = m_wire.find(tlv::PDRMNodeId);
-  if (val != m_wire.elements_end()) {
-    m_nodeId = readNonNegativeInteger(*val);
+  const Block& elements = selectors != nullptr ? selectors->m_wire : wire;
+  elements.parse();
+
+  Block::element_const_iterator val = elements.find(tlv::PDRMScope);
+  if (val != elements.elements_end()) {
+    uint64_t value = readNonNegativeInteger(*val);
+    if (selectors != nullptr)
+      selectors->m_scope = value;
   }
 
-  val = m_wire.find(tlv::PDRMHomeNetwork);
-  if (val != m_wire.elements_end()) {
-    m_homeNetwork = readNonNegativeInteger(*val);
+  val = elements.find(tlv::PDRMNodeId);
+  if (val != elements.elements_end()) {
+    uint64_t value = readNonNegativeInteger(*val);
+    if (selectors != nullptr)
+      selectors->m_nodeId = value;
   }
 
-  val = m_wire.find(tlv::PDRMPreferredLocation);
-  if (val != m_wire.elements_end()) {
-    m_preferredLocation = readNonNegativeInteger(*val);
+  val = elements.find(tlv::PDRMHomeNetwork);
+  if (val != elements.elements_end()) {
+    uint64_t value = readNonNegativeInteger(*val);
+    if (selectors != nullptr)
+      selectors->m_homeNetwork = value;
   }
 
-  val = m_wire.find(tlv::PDRMTimeSpentAtPreferredLocation);
-  if (val != m_wire.elements_end()) {
-    m_timeSpentAtPreferredLocation = readNonNegativeInteger(*val);
+  val = elements.find(tlv::PDRMPreferredLocation);
+  if (val != elements.elements_end()) {
+    uint64_t value = readNonNegativeInteger(*val);
+    if (selectors != nullptr)
+      selectors->m_preferredLocation = value;
   }
 
-  val = m_wire.find(tlv::PDRMCurrentPosition);
-  if (val != m_wire.elements_end()) {
-    m_currentPosition = readNonNegativeInteger(*val);
+  val = elements.find(tlv::PDRMTimeSpentAtPreferredLocation);
+  if (val != elements.elements_end()) {
+    uint64_t value = readNonNegativeInteger(*val);
+    if (selectors != nullptr)
+      selectors->m_timeSpentAtPreferredLocation = value;
   }
 
-  val = m_wire.find(tlv::PDRMAvailability);
-  if (val != m_wire.elements_end()) {
-    m_availability = readNonNegativeInteger(*val);
+  val = elements.find(tlv::PDRMCurrentPosition);
+  if (val != elements.elements_end()) {
+    uint64_t value = readNonNegativeInteger(*val);
+    if (selectors != nullptr)
+      selectors->m_currentPosition = value;
   }
 
-  val = m_wire.find(tlv::PDRMInterest);
-  if (val != m_wire.elements_end()) {
-    m_interest = true;
+  val = elements.find(tlv::PDRMAvailability);
+  if (val != elements.elements_end()) {
+    uint64_t value = readNonNegativeInteger(*val);
+    if (selectors != nullptr)
+      selectors->m_availability = value;
   }
 
+  val = elements.find(tlv::PDRMInterest);
+  if (val != elements.elements_end()) {
+    if (selectors != nullptr)
+      selectors->m_interest = true;
+  }
 }
 
 PDRMStrategySelectors&
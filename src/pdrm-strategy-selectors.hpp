@@ -75,6 +75,16 @@ public:
   void
   wireDecode(const Block& wire);
 
+  /**
+   * @brief Check that @p wire would be accepted by wireDecode, without decoding it
+   *
+   * @p wire is parsed in place, so that decoding a copy of it later does not parse it again.
+   *
+   * @throws tlv::Error if @p wire is malformed
+   */
+  static void
+  validate(const Block& wire);
+
 public: // getters & setters for replication selectors
 
   int32_t
@@ -159,6 +169,13 @@ public: // EqualityComparable concept
     return !this->operator==(other);
   }
 
+private:
+  /**
+   * @brief Decode @p wire into @p selectors, or only check it if @p selectors is nullptr
+   */
+  static void
+  decode(const Block& wire, PDRMStrategySelectors* selectors);
+
 private:
   int32_t m_scope;
   int32_t m_nodeId;
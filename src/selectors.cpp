@@ -133,49 +133,76 @@ Selectors::wireEncode() const
 
 void
 Selectors::wireDecode(const Block& wire)
+{
+  decode(wire, this);
+}
+
+void
+Selectors::validate(const Block& wire)
+{
+  decode(wire, nullptr);
+}
+
+void
+Selectors::decode(const Block& wire, Selectors* selectors)
 {
   if (wire.type() != tlv::Selectors)
     BOOST_THROW_EXCEPTION(tlv::Error("Unexpected TLV type when decoding Selectors"));
 
-  *this = Selectors();
-
-  m_wire = wire;
-  m_wire.parse();
+  if (selectors != nullptr) {
+    *selectors = Selectors();
+    selectors->m_wire = wire;
+  }
+  const Block& elements = selectors != nullptr ? selectors->m_wire : wire;
+  elements.parse();
 
   // MinSuffixComponents
-  Block::element_const_iterator val = m_wire.find(tlv::MinSuffixComponents);
-  if (val != m_wire.elements_end()) {
-    m_minSuffixComponents = readNonNegativeInteger(*val);
+  Block::element_const_iterator val = elements.find(tlv::MinSuffixComponents);
+  if (val != elements.elements_end()) {
+    int minSuffixComponents = readNonNegativeInteger(*val);
+    if (selectors != nullptr)
+      selectors->m_minSuffixComponents = minSuffixComponents;
   }
 
   // MaxSuffixComponents
-  val = m_wire.find(tlv::MaxSuffixComponents);
-  if (val != m_wire.elements_end()) {
-    m_maxSuffixComponents = readNonNegativeInteger(*val);
+  val = elements.find(tlv::MaxSuffixComponents);
+  if (val != elements.elements_end()) {
+    int maxSuffixComponents = readNonNegativeInteger(*val);
+    if (selectors != nullptr)
+      selectors->m_maxSuffixComponents = maxSuffixComponents;
   }
 
   // PublisherPublicKeyLocator
-  val = m_wire.find(tlv::KeyLocator);
-  if (val != m_wire.elements_end()) {
-    m_publisherPublicKeyLocator.wireDecode(*val);
+  val = elements.find(tlv::KeyLocator);
+  if (val != elements.elements_end()) {
+    if (selectors != nullptr)
+      selectors->m_publisherPublicKeyLocator.wireDecode(*val);
+    else
+      KeyLocator::validate(*val);
   }
 
   // Exclude
-  val = m_wire.find(tlv::Exclude);
-  if (val != m_wire.elements_end()) {
-    m_exclude.wireDecode(*val);
+  val = elements.find(tlv::Exclude);
+  if (val != elements.elements_end()) {
+    if (selectors != nullptr)
+      selectors->m_exclude.wireDecode(*val);
+    else
+      Exclude::validate(*val);
   }
 
   // ChildSelector
-  val = m_wire.find(tlv::ChildSelector);
-  if (val != m_wire.elements_end()) {
-    m_childSelector = readNonNegativeInteger(*val);
+  val = elements.find(tlv::ChildSelector);
+  if (val != elements.elements_end()) {
+    int childSelector = readNonNegativeInteger(*val);
+    if (selectors != nullptr)
+      selectors->m_childSelector = childSelector;
   }
 
   // MustBeFresh
-  val = m_wire.find(tlv::MustBeFresh);
-  if (val != m_wire.elements_end()) {
-    m_mustBeFresh = true;
+  val = elements.find(tlv::MustBeFresh);
+  if (val != elements.elements_end()) {
+    if (selectors != nullptr)
+      selectors->m_mustBeFresh = true;
   }
 }
 
@@ -74,6 +74,17 @@ public:
   void
   wireDecode(const Block& wire);
 
+  /**
+   * @brief Check that @p wire would be accepted by wireDecode, without decoding it
+   *
+   * @p wire and its nested elements are parsed in place, so that decoding a copy of it later
+   * does not parse them again.
+   *
+   * @throws tlv::Error if @p wire is malformed
+   */
+  static void
+  validate(const Block& wire);
+
 public: // getters & setters
   int
   getMinSuffixComponents() const
@@ -139,6 +150,13 @@ public: // EqualityComparable concept
     return !this->operator==(other);
   }
 
+private:
+  /**
+   * @brief Decode @p wire into @p selectors, or only check it if @p selectors is nullptr
+   */
+  static void
+  decode(const Block& wire, Selectors* selectors);
+
 private:
   int m_minSuffixComponents;
   int m_maxSuffixComponents;
@@ -94,7 +94,7 @@ void
 SignatureInfo::setValidityPeriod(const security::ValidityPeriod& validityPeriod)
 {
   unsetValidityPeriod();
-  m_otherTlvs.push_front(validityPeriod.wireEncode());
+  m_otherTlvs.insert(m_otherTlvs.begin(), validityPeriod.wireEncode());
 }
 
 void
@@ -119,6 +119,7 @@ SignatureInfo::getValidityPeriod() const
 void
 SignatureInfo::appendTypeSpecificTlv(const Block& block)
 {
+  m_wire.reset();
   m_otherTlvs.push_back(block);
 }
 
@@ -126,10 +127,9 @@ SignatureInfo::appendTypeSpecificTlv(const Block& block)
 const Block&
 SignatureInfo::getTypeSpecificTlv(uint32_t type) const
 {
-  for (std::list<Block>::const_iterator i = m_otherTlvs.begin();
-       i != m_otherTlvs.end(); i++) {
-    if (i->type() == type)
-      return *i;
+  for (const Block& block : m_otherTlvs) {
+    if (block.type() == type)
+      return block;
   }
 
   BOOST_THROW_EXCEPTION(Error("(SignatureInfo::getTypeSpecificTlv) Requested a non-existed type [" +
@@ -140,11 +140,15 @@ template<encoding::Tag TAG>
 size_t
 SignatureInfo::wireEncode(EncodingImpl<TAG>& encoder) const
 {
+  // the cached encoding (e.g., the bytes in a decoded Data packet) is copied as is
+  if (m_wire.hasWire()) {
+    return encoder.prependBlock(m_wire);
+  }
+
   size_t totalLength = 0;
 
-  for (std::list<Block>::const_reverse_iterator i = m_otherTlvs.rbegin();
-       i != m_otherTlvs.rend(); i++) {
-    totalLength += encoder.appendBlock(*i);
+  for (auto i = m_otherTlvs.rbegin(); i != m_otherTlvs.rend(); ++i) {
+    totalLength += encoder.prependBlock(*i);
   }
 
   if (m_hasKeyLocator)
@@ -182,24 +186,40 @@ SignatureInfo::wireEncode() const
 
 void
 SignatureInfo::wireDecode(const Block& wire)
+{
+  decode(wire, this);
+}
+
+void
+SignatureInfo::validate(const Block& wire)
+{
+  decode(wire, nullptr);
+}
+
+void
+SignatureInfo::decode(const Block& wire, SignatureInfo* info)
 {
   if (!wire.hasWire()) {
     BOOST_THROW_EXCEPTION(Error("The supplied block does not contain wire format"));
   }
 
-  m_hasKeyLocator = false;
-
-  m_wire = wire;
-  m_wire.parse();
+  if (info != nullptr) {
+    info->m_hasKeyLocator = false;
+    info->m_wire = wire;
+  }
+  const Block& elements = info != nullptr ? info->m_wire : wire;
+  elements.parse();
 
-  if (m_wire.type() != tlv::SignatureInfo)
+  if (elements.type() != tlv::SignatureInfo)
     BOOST_THROW_EXCEPTION(tlv::Error("Unexpected TLV type when decoding Name"));
 
-  Block::element_const_iterator it = m_wire.elements_begin();
+  Block::element_const_iterator it = elements.elements_begin();
 
   // the first block must be SignatureType
-  if (it != m_wire.elements_end() && it->type() == tlv::SignatureType) {
-    m_type = readNonNegativeInteger(*it);
+  if (it != elements.elements_end() && it->type() == tlv::SignatureType) {
+    int32_t type = readNonNegativeInteger(*it);
+    if (info != nullptr)
+      info->m_type = type;
     it++;
   }
   else
@@ -207,17 +227,20 @@ SignatureInfo::wireDecode(const Block& wire)
                                 "SignatureType"));
 
   // the second block could be KeyLocator
-  if (it != m_wire.elements_end() && it->type() == tlv::KeyLocator) {
-    m_keyLocator.wireDecode(*it);
-    m_hasKeyLocator = true;
+  if (it != elements.elements_end() && it->type() == tlv::KeyLocator) {
+    if (info != nullptr) {
+      info->m_keyLocator.wireDecode(*it);
+      info->m_hasKeyLocator = true;
+    }
+    else {
+      KeyLocator::validate(*it);
+    }
     it++;
   }
 
   // Decode the rest of type-specific TLVs, if any
-  while (it != m_wire.elements_end()) {
-    appendTypeSpecificTlv(*it);
-    it++;
-  }
+  if (info != nullptr)
+    info->m_otherTlvs.assign(it, elements.elements_end());
 }
 
 bool
@@ -25,7 +25,8 @@
 #include "encoding/tlv.hpp"
 #include "key-locator.hpp"
 #include "security/validity-period.hpp"
-#include <list>
+
+#include <vector>
 
 namespace ndn {
 
@@ -128,6 +129,17 @@ public:
   void
   wireDecode(const Block& wire);
 
+  /**
+   * @brief Check that @p wire would be accepted by wireDecode, without decoding it
+   *
+   * @p wire and its nested elements are parsed in place, so that decoding a copy of it later
+   * does not parse them again.
+   *
+   * @throws tlv::Error if @p wire is malformed
+   */
+  static void
+  validate(const Block& wire);
+
 public: // EqualityComparable concept
   bool
   operator==(const SignatureInfo& rhs) const;
@@ -138,12 +150,19 @@ public: // EqualityComparable concept
     return !(*this == rhs);
   }
 
+private:
+  /// @brief Decode @p wire into @p info, or only check it if @p info is nullptr
+  static void
+  decode(const Block& wire, SignatureInfo* info);
+
 private:
   int32_t m_type;
   bool m_hasKeyLocator;
   KeyLocator m_keyLocator;
-  std::list<Block> m_otherTlvs;
+  /// type-specific TLVs; a vector does not allocate while empty, which is the common case
+  std::vector<Block> m_otherTlvs;
 
+  /// wire encoding, which refers to the enclosing Data buffer after wireDecode
   mutable Block m_wire;
 };
 
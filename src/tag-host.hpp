@@ -25,15 +25,66 @@
 #include "common.hpp"
 #include "tag.hpp"
 
-#include <map>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+
+#include <cstring>
+#include <vector>
 
 namespace ndn {
 
+namespace detail {
+
+/** \brief allocate a new tag slot index
+ *
+ *  Slot indices are dense and start from zero; each call returns a new index.
+ */
+size_t
+allocateTagSlot();
+
+/** \brief slot index of tag type T within TagHost
+ *
+ *  The index is assigned when the type is first used and stays the same for the lifetime
+ *  of the process, regardless of the order in which tag types are encountered.
+ */
+template<typename T>
+inline size_t
+getTagSlot()
+{
+  static const size_t slot = allocateTagSlot();
+  return slot;
+}
+
+} // namespace detail
+
 /** \brief Base class to store tag information (e.g., inside Interest and Data packets)
+ *
+ *  Tags are kept in a flat array indexed by a per-type slot number, so that lookup does not
+ *  search or compare type identifiers. Small trivially copyable values can be stored inline
+ *  with setTagValue, which avoids allocating a Tag object for each packet.
+ *
+ *  setTag and getTag are unchanged in that respect: they hand out shared_ptr<T>, so every
+ *  setTag still needs a Tag object allocated by the caller, whatever its size. Existing
+ *  callers of setTag gain only the cheaper lookup; to avoid the allocation, a caller must be
+ *  converted to setTagValue and getTagValue. The two interfaces use separate storage, so a
+ *  value set with one is not visible through the other.
+ *
+ *  Inline values are keyed by a tag type that names their value type, so that tags with the
+ *  same representation are kept apart:
+ *
+ *      struct HopCountTag { typedef uint64_t ValueType; };
+ *      struct IncomingFaceIdTag { typedef uint64_t ValueType; };
+ *
+ *      interest.setTagValue<HopCountTag>(3);
+ *      interest.setTagValue<IncomingFaceIdTag>(256);
  */
 class TagHost
 {
 public:
+  /** \brief maximum size of a value stored with setTagValue
+   */
+  static const size_t MAX_INLINE_TAG_SIZE = 8;
+
   /** \brief get a tag item
    *  \tparam T type of the tag, which must be a subclass of ndn::Tag
    *  \retval nullptr if no Tag of type T is stored
@@ -45,6 +96,8 @@ public:
   /** \brief set a tag item
    *  \tparam T type of the tag, which must be a subclass of ndn::Tag
    *  \note Tag can be set even on a const tag host instance
+   *  \note The tag is stored by pointer even if T is small; use setTagValue to store a
+   *        small value without allocating
    */
   template<typename T>
   void
@@ -57,8 +110,79 @@ public:
   void
   removeTag() const;
 
+  /** \brief get a value stored inline
+   *  \tparam T type of the tag, whose T::ValueType is a trivially copyable type no larger
+   *             than MAX_INLINE_TAG_SIZE
+   *  \retval nullptr if no value of tag T is stored
+   *  \note The returned pointer is invalidated by the next change to the tags of this host
+   */
+  template<typename T>
+  const typename T::ValueType*
+  getTagValue() const;
+
+  /** \brief store a value inline, without allocating a Tag object
+   *  \tparam T type of the tag, whose T::ValueType is a trivially copyable type no larger
+   *             than MAX_INLINE_TAG_SIZE
+   *  \note Value can be set even on a const tag host instance
+   */
+  template<typename T>
+  void
+  setTagValue(const typename T::ValueType& value) const;
+
+  /** \brief remove a value stored inline
+   *  \tparam T type of the tag
+   *  \note Value can be removed even on a const tag host instance
+   */
+  template<typename T>
+  void
+  removeTagValue() const;
+
+private:
+  struct Entry
+  {
+    Entry()
+      : hasValue(false)
+    {
+    }
+
+    shared_ptr<Tag> tag;
+    bool hasValue;
+    typename std::aligned_storage<MAX_INLINE_TAG_SIZE>::type value;
+  };
+
+  Entry&
+  getOrCreateEntry(size_t slot) const
+  {
+    if (slot >= m_tags.size()) {
+      m_tags.resize(slot + 1);
+    }
+    return m_tags[slot];
+  }
+
+  void
+  shrink() const
+  {
+    while (!m_tags.empty() && m_tags.back().tag == nullptr && !m_tags.back().hasValue) {
+      m_tags.pop_back();
+    }
+  }
+
+  template<typename T>
+  static void
+  checkTagValueType()
+  {
+    static_assert(sizeof(T) <= MAX_INLINE_TAG_SIZE, "T is too large to be stored inline");
+    static_assert(boost::has_trivial_copy<T>::value && boost::has_trivial_destructor<T>::value,
+                  "T must be trivially copyable");
+  }
+
 private:
-  mutable std::map<size_t, shared_ptr<Tag>> m_tags;
+  /** \brief tags indexed by slot number
+   *
+   *  The array is empty until the first tag is set, so packets without tags pay nothing
+   *  beyond an empty vector, and it is trimmed when trailing slots become unused.
+   */
+  mutable std::vector<Entry> m_tags;
 };
 
 
@@ -68,11 +192,11 @@ TagHost::getTag() const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
 
-  auto it = m_tags.find(T::getTypeId());
-  if (it == m_tags.end()) {
+  size_t slot = detail::getTagSlot<T>();
+  if (slot >= m_tags.size()) {
     return nullptr;
   }
-  return static_pointer_cast<T>(it->second);
+  return static_pointer_cast<T>(m_tags[slot].tag);
 }
 
 template<typename T>
@@ -81,12 +205,16 @@ TagHost::setTag(shared_ptr<T> tag) const
 {
   static_assert(std::is_base_of<Tag, T>::value, "T must inherit from Tag");
 
+  size_t slot = detail::getTagSlot<T>();
   if (tag == nullptr) {
-    m_tags.erase(T::getTypeId());
+    if (slot < m_tags.size()) {
+      m_tags[slot].tag.reset();
+      this->shrink();
+    }
     return;
   }
 
-  m_tags[T::getTypeId()] = tag;
+  this->getOrCreateEntry(slot).tag = tag;
 }
 
 template<typename T>
@@ -96,6 +224,45 @@ TagHost::removeTag() const
   setTag<T>(nullptr);
 }
 
+template<typename T>
+inline const typename T::ValueType*
+TagHost::getTagValue() const
+{
+  typedef typename T::ValueType ValueType;
+  checkTagValueType<ValueType>();
+
+  size_t slot = detail::getTagSlot<T>();
+  if (slot >= m_tags.size() || !m_tags[slot].hasValue) {
+    return nullptr;
+  }
+  return reinterpret_cast<const ValueType*>(&m_tags[slot].value);
+}
+
+template<typename T>
+inline void
+TagHost::setTagValue(const typename T::ValueType& value) const
+{
+  typedef typename T::ValueType ValueType;
+  checkTagValueType<ValueType>();
+
+  Entry& entry = this->getOrCreateEntry(detail::getTagSlot<T>());
+  std::memcpy(&entry.value, &value, sizeof(ValueType));
+  entry.hasValue = true;
+}
+
+template<typename T>
+inline void
+TagHost::removeTagValue() const
+{
+  checkTagValueType<typename T::ValueType>();
+
+  size_t slot = detail::getTagSlot<T>();
+  if (slot < m_tags.size()) {
+    m_tags[slot].hasValue = false;
+    this->shrink();
+  }
+}
+
 } // namespace ndn
 
 #endif // NDN_TAG_HOST_HPP
@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "send-queue-monitor.hpp"
+
+#include <algorithm>
+#include <ostream>
+
+namespace ndn {
+
+SendQueueStatistics::SendQueueStatistics()
+  : nQueuedBytes(0)
+  , nQueuedPackets(0)
+  , maxQueuedBytes(0)
+  , maxQueuedPackets(0)
+  , nUnwritable(0)
+  , unwritableTime(time::nanoseconds::zero())
+{
+}
+
+std::ostream&
+operator<<(std::ostream& os, const SendQueueStatistics& statistics)
+{
+  return os << "queued=" << statistics.nQueuedBytes << "B/" << statistics.nQueuedPackets
+            << " max=" << statistics.maxQueuedBytes << "B/" << statistics.maxQueuedPackets
+            << " unwritable=" << statistics.nUnwritable
+            << " unwritableTime=" << statistics.unwritableTime.count() << "ns";
+}
+
+SendQueueMonitor::SendQueueMonitor()
+  : m_lowWatermark(0)
+  , m_highWatermark(0)
+  , m_isWritable(true)
+{
+}
+
+void
+SendQueueMonitor::setWatermarks(size_t lowWatermark, size_t highWatermark)
+{
+  BOOST_ASSERT(highWatermark == 0 || lowWatermark <= highWatermark);
+  m_lowWatermark = lowWatermark;
+  m_highWatermark = highWatermark;
+  updateWritability();
+}
+
+void
+SendQueueMonitor::enqueue(size_t nBytes, size_t nPackets)
+{
+  m_statistics.nQueuedBytes += nBytes;
+  m_statistics.nQueuedPackets += nPackets;
+  m_statistics.maxQueuedBytes = std::max(m_statistics.maxQueuedBytes,
+                                         m_statistics.nQueuedBytes);
+  m_statistics.maxQueuedPackets = std::max(m_statistics.maxQueuedPackets,
+                                           m_statistics.nQueuedPackets);
+  if (m_isWritable) {
+    updateWritability();
+  }
+}
+
+void
+SendQueueMonitor::dequeue(size_t nBytes, size_t nPackets)
+{
+  BOOST_ASSERT(nBytes <= m_statistics.nQueuedBytes && nPackets <= m_statistics.nQueuedPackets);
+  m_statistics.nQueuedBytes -= nBytes;
+  m_statistics.nQueuedPackets -= nPackets;
+  if (!m_isWritable) {
+    updateWritability();
+  }
+}
+
+void
+SendQueueMonitor::clear()
+{
+  m_statistics.nQueuedBytes = 0;
+  m_statistics.nQueuedPackets = 0;
+  updateWritability();
+}
+
+SendQueueStatistics
+SendQueueMonitor::getStatistics() const
+{
+  SendQueueStatistics statistics = m_statistics;
+  if (!m_isWritable) {
+    statistics.unwritableTime += time::steady_clock::now() - m_unwritableSince;
+  }
+  return statistics;
+}
+
+void
+SendQueueMonitor::resetStatistics()
+{
+  m_statistics.maxQueuedBytes = m_statistics.nQueuedBytes;
+  m_statistics.maxQueuedPackets = m_statistics.nQueuedPackets;
+  m_statistics.nUnwritable = 0;
+  m_statistics.unwritableTime = time::nanoseconds::zero();
+  if (!m_isWritable) {
+    m_unwritableSince = time::steady_clock::now();
+  }
+}
+
+void
+SendQueueMonitor::updateWritability()
+{
+  bool isWritable = m_isWritable;
+  if (m_highWatermark == 0) {
+    isWritable = true;
+  }
+  else if (m_statistics.nQueuedBytes > m_highWatermark) {
+    isWritable = false;
+  }
+  else if (m_statistics.nQueuedBytes <= m_lowWatermark) {
+    isWritable = true;
+  }
+
+  if (isWritable == m_isWritable) {
+    return;
+  }
+
+  m_isWritable = isWritable;
+  if (isWritable) {
+    m_statistics.unwritableTime += time::steady_clock::now() - m_unwritableSince;
+  }
+  else {
+    ++m_statistics.nUnwritable;
+    m_unwritableSince = time::steady_clock::now();
+  }
+
+  if (m_writabilityCallback) {
+    m_writabilityCallback(isWritable);
+  }
+}
+
+} // namespace ndn
@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_SEND_QUEUE_MONITOR_HPP
+#define NDN_TRANSPORT_SEND_QUEUE_MONITOR_HPP
+
+#include "../common.hpp"
+#include "../util/time.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Counters of a send queue
+ */
+struct SendQueueStatistics
+{
+  SendQueueStatistics();
+
+  /// bytes currently queued
+  uint64_t nQueuedBytes;
+  /// packets currently queued
+  uint64_t nQueuedPackets;
+  /// largest number of bytes queued at once
+  uint64_t maxQueuedBytes;
+  /// largest number of packets queued at once
+  uint64_t maxQueuedPackets;
+  /// how many times the queue became unwritable
+  uint64_t nUnwritable;
+  /// total time the queue has been unwritable, measured with time::steady_clock
+  time::nanoseconds unwritableTime;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const SendQueueStatistics& statistics);
+
+/**
+ * @brief Tracks the bytes queued for sending against a high and a low watermark
+ *
+ * The queue becomes unwritable when the queued bytes exceed the high watermark, and writable
+ * again when they drop to the low watermark.  Packets are never refused: producers are
+ * expected to pause while the queue is unwritable.
+ */
+class SendQueueMonitor : noncopyable
+{
+public:
+  typedef function<void(bool isWritable)> WritabilityCallback;
+
+  SendQueueMonitor();
+
+  /**
+   * @brief Set the watermarks on queued bytes
+   * @param lowWatermark the queue becomes writable when queued bytes drop to this value
+   * @param highWatermark the queue becomes unwritable when queued bytes exceed this value;
+   *                      zero disables the watermarks, so the queue is always writable
+   * @pre lowWatermark <= highWatermark, unless highWatermark is zero
+   */
+  void
+  setWatermarks(size_t lowWatermark, size_t highWatermark);
+
+  /**
+   * @brief Set the function invoked whenever the queue becomes writable or unwritable
+   */
+  void
+  setWritabilityCallback(const WritabilityCallback& callback)
+  {
+    m_writabilityCallback = callback;
+  }
+
+  bool
+  isWritable() const
+  {
+    return m_isWritable;
+  }
+
+  /**
+   * @brief Account for @p nPackets packets of @p nBytes bytes in total entering the queue
+   */
+  void
+  enqueue(size_t nBytes, size_t nPackets = 1);
+
+  /**
+   * @brief Account for @p nPackets packets of @p nBytes bytes in total leaving the queue
+   */
+  void
+  dequeue(size_t nBytes, size_t nPackets = 1);
+
+  /**
+   * @brief Account for the whole queue being discarded
+   */
+  void
+  clear();
+
+  /**
+   * @return the counters, with the unwritable time including the current unwritable period
+   */
+  SendQueueStatistics
+  getStatistics() const;
+
+  /**
+   * @brief Reset the maxima and the unwritable counters; the current depth is kept
+   */
+  void
+  resetStatistics();
+
+private:
+  void
+  updateWritability();
+
+private:
+  SendQueueStatistics m_statistics;
+  size_t m_lowWatermark;
+  size_t m_highWatermark;
+  bool m_isWritable;
+  time::steady_clock::TimePoint m_unwritableSince;
+  WritabilityCallback m_writabilityCallback;
+};
+
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_SEND_QUEUE_MONITOR_HPP
@@ -0,0 +1,250 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_SHM_RING_HPP
+#define NDN_TRANSPORT_SHM_RING_HPP
+
+#include "../common.hpp"
+#include "../encoding/block.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+namespace ndn {
+
+/**
+ * @brief Single-producer/single-consumer ring of TLV blocks in shared memory
+ *
+ * ShmRing is a view over memory that starts with a control area of CONTROL_SIZE bytes,
+ * followed by the data area.  Producer and consumer may be different processes that map
+ * the same memory.  Each record is a 4-byte length in host byte order followed by the wire
+ * encoding, padded to a multiple of 8 bytes.  A record that does not fit before the end of
+ * the data area is preceded by a wrap marker and written at the beginning.
+ */
+class ShmRing : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /// size of the control area at the beginning of the ring memory
+  static const size_t CONTROL_SIZE = 192;
+
+  /**
+   * @return size of the memory of a ring with @p capacity bytes of data area
+   */
+  static size_t
+  getMemorySize(size_t capacity)
+  {
+    return CONTROL_SIZE + capacity;
+  }
+
+  /**
+   * @param memory getMemorySize(capacity) bytes of memory, aligned to 64 bytes
+   * @param capacity size of the data area, a power of two not less than 64
+   */
+  ShmRing(uint8_t* memory, size_t capacity)
+    : m_control(reinterpret_cast<Control*>(memory))
+    , m_data(memory + CONTROL_SIZE)
+    , m_capacity(capacity)
+  {
+    BOOST_ASSERT(capacity >= 64 && (capacity & (capacity - 1)) == 0);
+  }
+
+  /**
+   * @brief Make the ring empty; only done by the process that creates the memory
+   */
+  void
+  reset()
+  {
+    m_control->writePosition.store(0, std::memory_order_relaxed);
+    m_control->readPosition.store(0, std::memory_order_relaxed);
+    m_control->isProducerWaiting.store(0, std::memory_order_release);
+  }
+
+  /**
+   * @brief Append the wire encoding of @p wire as one record (producer only)
+   * @return false if the ring does not have enough free space
+   */
+  bool
+  write(const Block& wire)
+  {
+    return writeRecord(wire.wire(), wire.size(), nullptr, 0);
+  }
+
+  /**
+   * @brief Append @p header and @p payload together as one record (producer only)
+   * @return false if the ring does not have enough free space
+   */
+  bool
+  write(const Block& header, const Block& payload)
+  {
+    return writeRecord(header.wire(), header.size(), payload.wire(), payload.size());
+  }
+
+  /**
+   * @brief Remove up to @p maxRecords records, appending a copy of each to @p blocks
+   *        (consumer only)
+   * @return number of records read
+   * @throw Error the ring contents are corrupted
+   */
+  size_t
+  read(std::vector<Block>& blocks, size_t maxRecords = std::numeric_limits<size_t>::max())
+  {
+    uint64_t readPosition = m_control->readPosition.load(std::memory_order_relaxed);
+    uint64_t writePosition = m_control->writePosition.load(std::memory_order_acquire);
+
+    size_t nRecords = 0;
+    while (readPosition != writePosition && nRecords < maxRecords) {
+      size_t offset = readPosition & (m_capacity - 1);
+      uint32_t length = 0;
+      std::memcpy(&length, m_data + offset, sizeof(length));
+      if (length == WRAP_MARKER) {
+        readPosition += m_capacity - offset;
+        continue;
+      }
+      // checked before computing the record size, which could overflow size_t otherwise
+      if (length > m_capacity - offset - sizeof(length) ||
+          getRecordSize(length) > m_capacity - offset)
+        BOOST_THROW_EXCEPTION(Error("Shared memory ring record exceeds the ring"));
+
+      const uint8_t* begin = m_data + offset + sizeof(length);
+      bool isOk = false;
+      Block block;
+      std::tie(isOk, block) = Block::fromBuffer(make_shared<Buffer>(begin, length), 0);
+      if (!isOk || block.size() != length)
+        BOOST_THROW_EXCEPTION(Error("Shared memory ring record is not a TLV block"));
+
+      blocks.push_back(block);
+      readPosition += getRecordSize(length);
+      ++nRecords;
+    }
+
+    m_control->readPosition.store(readPosition, std::memory_order_release);
+    return nRecords;
+  }
+
+  bool
+  isEmpty() const
+  {
+    return m_control->readPosition.load(std::memory_order_acquire) ==
+           m_control->writePosition.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Mark whether the producer waits for free space
+   *
+   * A producer that finds the ring full sets the mark and then retries the write, so that
+   * space freed in between is not missed.  The consumer signals the producer after freeing
+   * space in a ring with the mark set.
+   *
+   * Each side stores one variable and then loads the one stored by the other side, so a
+   * full fence separates the two on both sides: otherwise the producer could still see the
+   * old read position while the consumer still sees the mark unset, and the wake-up would be
+   * lost.
+   */
+  void
+  setProducerWaiting(bool isWaiting)
+  {
+    m_control->isProducerWaiting.store(isWaiting ? 1 : 0, std::memory_order_seq_cst);
+    // before the retried write loads the read position
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  /**
+   * @brief Check the mark set by setProducerWaiting (consumer only)
+   */
+  bool
+  isProducerWaiting() const
+  {
+    // after read stored the read position
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return m_control->isProducerWaiting.load(std::memory_order_seq_cst) != 0;
+  }
+
+private:
+  static size_t
+  getRecordSize(size_t length)
+  {
+    return (sizeof(uint32_t) + length + 7) & ~static_cast<size_t>(7);
+  }
+
+  bool
+  writeRecord(const uint8_t* first, size_t firstSize, const uint8_t* second, size_t secondSize)
+  {
+    size_t length = firstSize + secondSize;
+    size_t recordSize = getRecordSize(length);
+    if (recordSize > m_capacity)
+      return false;
+
+    uint64_t writePosition = m_control->writePosition.load(std::memory_order_relaxed);
+    uint64_t readPosition = m_control->readPosition.load(std::memory_order_acquire);
+    size_t offset = writePosition & (m_capacity - 1);
+    size_t padding = m_capacity - offset < recordSize ? m_capacity - offset : 0;
+    if (writePosition + padding + recordSize - readPosition > m_capacity)
+      return false;
+
+    if (padding > 0) {
+      uint32_t marker = WRAP_MARKER;
+      std::memcpy(m_data + offset, &marker, sizeof(marker));
+      writePosition += padding;
+      offset = 0;
+    }
+
+    uint32_t length32 = static_cast<uint32_t>(length);
+    uint8_t* record = m_data + offset;
+    std::memcpy(record, &length32, sizeof(length32));
+    std::memcpy(record + sizeof(length32), first, firstSize);
+    if (secondSize > 0)
+      std::memcpy(record + sizeof(length32) + firstSize, second, secondSize);
+
+    m_control->writePosition.store(writePosition + recordSize, std::memory_order_release);
+    return true;
+  }
+
+private:
+  struct Control
+  {
+    alignas(64) std::atomic<uint64_t> writePosition;
+    alignas(64) std::atomic<uint64_t> readPosition;
+    alignas(64) std::atomic<uint32_t> isProducerWaiting;
+  };
+  static_assert(sizeof(Control) <= CONTROL_SIZE, "Control does not fit in the control area");
+  static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Shared memory rings need lock-free 64-bit atomics");
+
+  static const uint32_t WRAP_MARKER = 0xFFFFFFFF;
+
+  Control* m_control;
+  uint8_t* m_data;
+  size_t m_capacity;
+};
+
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_SHM_RING_HPP
@@ -0,0 +1,614 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "common.hpp"
+
+#include "shm-transport.hpp"
+#include "util/face-uri.hpp"
+
+#if defined(NDN_CXX_HAVE_EVENTFD)
+
+#include "shm-ring.hpp"
+
+#include <cerrno>
+#include <deque>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ndn {
+
+class ShmTransport::Impl
+{
+public:
+  Impl(ShmTransport& transport, boost::asio::io_service& ioService)
+    : m_transport(transport)
+    , m_socket(ioService)
+    , m_event(ioService)
+    , m_peerEventFd(-1)
+    , m_memory(nullptr)
+    , m_memorySize(0)
+    , m_eventCounter(0)
+    , m_peerByte(0)
+    , m_isConnectionInProgress(false)
+    , m_isNotifyScheduled(false)
+    , m_isWaitingForEvent(false)
+  {
+  }
+
+  ~Impl()
+  {
+    close();
+  }
+
+  void
+  connect(const std::string& socketPath)
+  {
+    if (m_isConnectionInProgress || m_transport.m_isConnected)
+      return;
+
+    m_isConnectionInProgress = true;
+    m_socket.async_connect(boost::asio::local::stream_protocol::endpoint(socketPath),
+                           bind(&Impl::handleConnect, this, _1));
+  }
+
+  void
+  close()
+  {
+    m_isConnectionInProgress = false;
+
+    boost::system::error_code error; // to silently ignore all errors
+    m_socket.cancel(error);
+    m_socket.close(error);
+    m_event.cancel(error);
+    m_event.close(error);
+    m_isWaitingForEvent = false;
+
+    if (m_peerEventFd >= 0) {
+      ::close(m_peerEventFd);
+      m_peerEventFd = -1;
+    }
+    m_txRing.reset();
+    m_rxRing.reset();
+    if (m_memory != nullptr) {
+      ::munmap(m_memory, m_memorySize);
+      m_memory = nullptr;
+    }
+
+    m_transport.m_isConnected = false;
+    m_transport.m_isExpectingData = false;
+    m_sendQueue.clear();
+    m_transport.m_sendQueueMonitor.clear();
+  }
+
+  /**
+   * @brief Stop delivering received blocks
+   *
+   * The eventfd of the forwarder also signals that space was freed in the ring of outgoing
+   * blocks, so the transport keeps waiting on it while blocks are queued for sending.
+   */
+  void
+  pause()
+  {
+    if (m_isConnectionInProgress)
+      return;
+
+    if (m_transport.m_isExpectingData) {
+      m_transport.m_isExpectingData = false;
+      if (m_isWaitingForEvent && m_sendQueue.empty()) {
+        m_isWaitingForEvent = false;
+        m_event.cancel();
+      }
+    }
+  }
+
+  void
+  resume()
+  {
+    if (m_isConnectionInProgress)
+      return;
+
+    if (!m_transport.m_isExpectingData) {
+      m_transport.m_isExpectingData = true;
+      if (m_transport.m_isConnected) {
+        asyncWaitForEvent();
+        // blocks written while paused may have been signalled already
+        m_transport.m_ioService->post(bind(&Impl::handleResume, this));
+      }
+    }
+  }
+
+  void
+  send(const Block& header, const Block& payload)
+  {
+    if (m_transport.m_isConnected && m_sendQueue.empty()) {
+      bool isWritten = payload.hasWire() ? m_txRing->write(header, payload) :
+                                           m_txRing->write(header);
+      if (isWritten) {
+        scheduleNotify();
+        return;
+      }
+    }
+
+    // if not connected or the ring is full, the blocks are written
+    // either after the handshake or when the forwarder frees space
+    m_sendQueue.push_back(std::make_pair(header, payload));
+    m_transport.m_sendQueueMonitor.enqueue(getRecordSize(header, payload));
+    if (m_transport.m_isConnected) {
+      flushSendQueue();
+      if (!m_sendQueue.empty()) {
+        // wait for the forwarder to free space, even if paused
+        asyncWaitForEvent();
+      }
+    }
+  }
+
+private:
+  void
+  handleConnect(const boost::system::error_code& error)
+  {
+    if (error) {
+      if (error == boost::system::errc::operation_canceled)
+        return;
+
+      m_transport.close();
+      BOOST_THROW_EXCEPTION(Transport::Error(error, "error while connecting to the forwarder"));
+    }
+
+    // wait until the forwarder hands out the shared memory
+    m_socket.async_receive(boost::asio::null_buffers(),
+                           bind(&Impl::handleHandshake, this, _1));
+  }
+
+  void
+  handleHandshake(const boost::system::error_code& error)
+  {
+    if (error) {
+      if (error == boost::system::errc::operation_canceled)
+        return;
+
+      m_transport.close();
+      BOOST_THROW_EXCEPTION(Transport::Error(error, "error while receiving shared memory "
+                                                    "from the forwarder"));
+    }
+
+    try {
+      receiveSharedMemory();
+    }
+    catch (const Transport::Error&) {
+      m_transport.close();
+      throw;
+    }
+
+    m_isConnectionInProgress = false;
+    m_transport.m_isConnected = true;
+
+    m_socket.async_receive(boost::asio::buffer(&m_peerByte, sizeof(m_peerByte)),
+                           bind(&Impl::handlePeerClosed, this, _1));
+    m_transport.m_isExpectingData = true;
+    asyncWaitForEvent();
+    flushSendQueue();
+  }
+
+  void
+  receiveSharedMemory()
+  {
+    static const size_t N_FDS = 3;
+
+    uint64_t capacity = 0;
+    iovec iov;
+    iov.iov_base = &capacity;
+    iov.iov_len = sizeof(capacity);
+
+    union {
+      cmsghdr header;
+      uint8_t buffer[CMSG_SPACE(N_FDS * sizeof(int))];
+    } control;
+
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+
+    ssize_t nBytesRecvd = ::recvmsg(m_socket.native_handle(), &message,
+                                    MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+    if (nBytesRecvd < 0) {
+      boost::system::error_code error(errno, boost::system::system_category());
+      BOOST_THROW_EXCEPTION(Transport::Error(error, "error while receiving shared memory "
+                                                    "from the forwarder"));
+    }
+
+    int fds[N_FDS] = {-1, -1, -1};
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+    if (cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS &&
+        cmsg->cmsg_len == CMSG_LEN(N_FDS * sizeof(int))) {
+      std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+    }
+    else if (cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+      // close whatever was passed
+      size_t nPassed = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      for (size_t i = 0; i < nPassed; ++i) {
+        int fd = -1;
+        std::memcpy(&fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+        ::close(fd);
+      }
+    }
+
+    bool isValid = nBytesRecvd == sizeof(capacity) && fds[0] >= 0 &&
+                   capacity >= 64 && (capacity & (capacity - 1)) == 0 &&
+                   capacity <= std::numeric_limits<uint32_t>::max();
+    if (!isValid) {
+      for (int fd : fds) {
+        if (fd >= 0)
+          ::close(fd);
+      }
+      BOOST_THROW_EXCEPTION(Transport::Error("Malformed shared memory handshake "
+                                             "from the forwarder"));
+    }
+
+    size_t ringSize = ShmRing::getMemorySize(capacity);
+    struct stat memoryStat;
+    if (::fstat(fds[0], &memoryStat) != 0 || memoryStat.st_size < 0 ||
+        static_cast<uint64_t>(memoryStat.st_size) < 2 * ringSize) {
+      for (int fd : fds) {
+        ::close(fd);
+      }
+      // mapping it would raise SIGBUS on access beyond its end
+      BOOST_THROW_EXCEPTION(Transport::Error("Shared memory from the forwarder is smaller "
+                                             "than its rings"));
+    }
+
+    void* memory = ::mmap(nullptr, 2 * ringSize, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+    ::close(fds[0]);
+    if (memory == MAP_FAILED) {
+      boost::system::error_code error(errno, boost::system::system_category());
+      ::close(fds[1]);
+      ::close(fds[2]);
+      BOOST_THROW_EXCEPTION(Transport::Error(error, "cannot map shared memory of the forwarder"));
+    }
+
+    m_memory = memory;
+    m_memorySize = 2 * ringSize;
+    m_txRing.reset(new ShmRing(static_cast<uint8_t*>(memory), capacity));
+    m_rxRing.reset(new ShmRing(static_cast<uint8_t*>(memory) + ringSize, capacity));
+    m_event.assign(fds[1]);
+    m_peerEventFd = fds[2];
+  }
+
+  void
+  handlePeerClosed(const boost::system::error_code& error)
+  {
+    if (error == boost::system::errc::operation_canceled)
+      return;
+
+    // the forwarder never writes to the socket after the handshake
+    m_transport.close();
+    BOOST_THROW_EXCEPTION(Transport::Error(error, "forwarder ended the shared memory session"));
+  }
+
+  void
+  asyncWaitForEvent()
+  {
+    if (m_isWaitingForEvent)
+      return;
+
+    m_isWaitingForEvent = true;
+    m_event.async_read_some(boost::asio::buffer(&m_eventCounter, sizeof(m_eventCounter)),
+                            bind(&Impl::handleEvent, this, _1));
+  }
+
+  void
+  handleEvent(const boost::system::error_code& error)
+  {
+    if (error) {
+      if (error == boost::system::errc::operation_canceled)
+        return;
+
+      m_transport.close();
+      BOOST_THROW_EXCEPTION(Transport::Error(error, "error while waiting for the forwarder"));
+    }
+    m_isWaitingForEvent = false;
+
+    // while paused, received blocks stay in the ring until resume
+    m_receivedBlocks.clear();
+    if (m_transport.m_isExpectingData) {
+      readRing();
+    }
+    flushSendQueue();
+
+    if (m_transport.m_isExpectingData || !m_sendQueue.empty()) {
+      asyncWaitForEvent();
+    }
+    if (!m_receivedBlocks.empty()) {
+      m_transport.receive(m_receivedBlocks);
+    }
+  }
+
+  void
+  handleResume()
+  {
+    if (!m_transport.m_isConnected || !m_transport.m_isExpectingData)
+      return;
+
+    m_receivedBlocks.clear();
+    readRing();
+    if (!m_receivedBlocks.empty()) {
+      m_transport.receive(m_receivedBlocks);
+    }
+  }
+
+  void
+  readRing()
+  {
+    try {
+      m_rxRing->read(m_receivedBlocks);
+    }
+    catch (const ShmRing::Error& e) {
+      m_transport.close();
+      BOOST_THROW_EXCEPTION(Transport::Error(e.what()));
+    }
+
+    if (m_rxRing->isProducerWaiting()) {
+      m_rxRing->setProducerWaiting(false);
+      notifyPeer();
+    }
+  }
+
+  void
+  flushSendQueue()
+  {
+    bool isWritten = false;
+    while (!m_sendQueue.empty()) {
+      if (!writeFront()) {
+        m_txRing->setProducerWaiting(true);
+        // the forwarder may have freed space before seeing the mark
+        if (!writeFront())
+          break;
+      }
+      isWritten = true;
+    }
+
+    if (isWritten) {
+      scheduleNotify();
+    }
+  }
+
+  bool
+  writeFront()
+  {
+    const std::pair<Block, Block>& front = m_sendQueue.front();
+    bool isWritten = front.second.hasWire() ? m_txRing->write(front.first, front.second) :
+                                              m_txRing->write(front.first);
+    if (isWritten) {
+      m_transport.m_sendQueueMonitor.dequeue(getRecordSize(front.first, front.second));
+      m_sendQueue.pop_front();
+    }
+    return isWritten;
+  }
+
+  static size_t
+  getRecordSize(const Block& header, const Block& payload)
+  {
+    return header.size() + (payload.hasWire() ? payload.size() : 0);
+  }
+
+  /**
+   * @brief Signal the forwarder once for all blocks written in the current handler
+   */
+  void
+  scheduleNotify()
+  {
+    if (!m_isNotifyScheduled) {
+      m_isNotifyScheduled = true;
+      m_transport.m_ioService->post(bind(&Impl::notifyPeer, this));
+    }
+  }
+
+  void
+  notifyPeer()
+  {
+    m_isNotifyScheduled = false;
+    if (m_peerEventFd < 0)
+      return;
+
+    uint64_t increment = 1;
+    ssize_t nBytesWritten = ::write(m_peerEventFd, &increment, sizeof(increment));
+    static_cast<void>(nBytesWritten); // counter overflow means the forwarder is signalled already
+  }
+
+private:
+  ShmTransport& m_transport;
+
+  boost::asio::local::stream_protocol::socket m_socket;
+  boost::asio::posix::stream_descriptor m_event; ///< eventfd signalled by the forwarder
+  int m_peerEventFd; ///< eventfd signalled by this transport
+
+  void* m_memory;
+  size_t m_memorySize;
+  unique_ptr<ShmRing> m_txRing;
+  unique_ptr<ShmRing> m_rxRing;
+
+  std::deque<std::pair<Block, Block>> m_sendQueue; ///< header and optional payload
+  std::vector<Block> m_receivedBlocks;
+
+  uint64_t m_eventCounter;
+  uint8_t m_peerByte;
+  bool m_isConnectionInProgress;
+  bool m_isNotifyScheduled;
+  bool m_isWaitingForEvent; ///< a read of m_event is pending and not cancelled
+};
+
+} // namespace ndn
+
+// done with defined(NDN_CXX_HAVE_EVENTFD)
+#else // shared memory transport is not supported
+
+namespace ndn {
+
+class ShmTransport::Impl
+{
+public:
+  Impl(ShmTransport&, boost::asio::io_service&)
+  {
+  }
+
+  void
+  connect(const std::string&)
+  {
+    BOOST_THROW_EXCEPTION(Transport::Error("Shared memory transport is not supported "
+                                           "on this platform"));
+  }
+
+  void
+  close()
+  {
+  }
+
+  void
+  pause()
+  {
+  }
+
+  void
+  resume()
+  {
+  }
+
+  void
+  send(const Block&, const Block&)
+  {
+  }
+};
+
+} // namespace ndn
+
+#endif // shared memory transport is not supported
+
+namespace ndn {
+
+ShmTransport::ShmTransport(const std::string& socketPath)
+  : m_socketPath(socketPath)
+{
+}
+
+ShmTransport::~ShmTransport()
+{
+}
+
+std::string
+ShmTransport::getDefaultSocketName(const ConfigFile& config)
+{
+  const ConfigFile::Parsed& parsed = config.getParsedConfiguration();
+
+  try
+    {
+      const util::FaceUri uri(parsed.get<std::string>("transport"));
+
+      if (uri.getScheme() != "shm")
+        {
+          BOOST_THROW_EXCEPTION(Transport::Error("Cannot create ShmTransport from \"" +
+                                                 uri.getScheme() + "\" URI"));
+        }
+
+      if (!uri.getPath().empty())
+        {
+          return uri.getPath();
+        }
+    }
+  catch (const boost::property_tree::ptree_bad_path& error)
+    {
+      // no transport specified
+    }
+  catch (const boost::property_tree::ptree_bad_data& error)
+    {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error(error.what()));
+    }
+  catch (const util::FaceUri::Error& error)
+    {
+      BOOST_THROW_EXCEPTION(ConfigFile::Error(error.what()));
+    }
+
+  // Assume the default socket location.
+  return "/var/run/nfd-shm.sock";
+}
+
+shared_ptr<ShmTransport>
+ShmTransport::create(const ConfigFile& config)
+{
+  return make_shared<ShmTransport>(getDefaultSocketName(config));
+}
+
+void
+ShmTransport::connect(boost::asio::io_service& ioService,
+                      const ReceiveCallback& receiveCallback)
+{
+  if (m_impl == nullptr) {
+    Transport::connect(ioService, receiveCallback);
+
+    m_impl.reset(new Impl(*this, ioService));
+  }
+
+  m_impl->connect(m_socketPath);
+}
+
+void
+ShmTransport::send(const Block& wire)
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->send(wire, Block());
+}
+
+void
+ShmTransport::send(const Block& header, const Block& payload)
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->send(header, payload);
+}
+
+void
+ShmTransport::close()
+{
+  // the Impl is kept, as close() may be called from within its handlers
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->close();
+}
+
+void
+ShmTransport::pause()
+{
+  if (m_impl != nullptr) {
+    m_impl->pause();
+  }
+}
+
+void
+ShmTransport::resume()
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->resume();
+}
+
+} // namespace ndn
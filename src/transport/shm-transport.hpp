@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2014 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_SHM_TRANSPORT_HPP
+#define NDN_TRANSPORT_SHM_TRANSPORT_HPP
+
+#include "../common.hpp"
+#include "transport.hpp"
+#include "../util/config-file.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Transport to a forwarder on the same host through a pair of shared memory rings
+ *
+ * The forwarder listens on a unix stream socket.  After accepting a connection, it sends a
+ * single message with the ring capacity as a uint64_t in host byte order, and passes three
+ * file descriptors with SCM_RIGHTS:
+ *  - the shared memory, holding the ring to the forwarder followed by the ring to the
+ *    application, each of ShmRing::getMemorySize(capacity) bytes;
+ *  - an eventfd the forwarder signals after writing to the ring to the application, or
+ *    after freeing space in the ring to the forwarder while the application waits for it;
+ *  - an eventfd the application signals in the same situations with the roles reversed.
+ *
+ * The socket stays open for the duration of the session; closing it ends the session.
+ * Blocks are written directly into the rings, and the wake-ups for a burst of sends are
+ * coalesced into one eventfd write.
+ */
+class ShmTransport : public Transport
+{
+public:
+  explicit
+  ShmTransport(const std::string& socketPath);
+
+  ~ShmTransport();
+
+  using Transport::connect;
+
+  // from Transport
+  virtual void
+  connect(boost::asio::io_service& ioService,
+          const ReceiveCallback& receiveCallback);
+
+  virtual void
+  close();
+
+  virtual void
+  pause();
+
+  virtual void
+  resume();
+
+  virtual void
+  send(const Block& wire);
+
+  virtual void
+  send(const Block& header, const Block& payload);
+
+  /**
+   * @brief Create shared memory transport to the socket given as transport=shm://<path>
+   *        in the configuration file
+   *
+   * @throws Transport::Error if the transport is not a shm:// URI
+   * @throws ConfigFile::Error if the transport URI is malformed
+   */
+  static shared_ptr<ShmTransport>
+  create(const ConfigFile& config);
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /**
+   * Determine the socket on which the forwarder offers shared memory sessions
+   *
+   * @returns path of transport value if present in config, else /var/run/nfd-shm.sock
+   * @throws Transport::Error if the transport is not a shm:// URI
+   * @throws ConfigFile::Error if the transport URI is malformed
+   */
+  static std::string
+  getDefaultSocketName(const ConfigFile& config);
+
+private:
+  std::string m_socketPath;
+
+  class Impl;
+  unique_ptr<Impl> m_impl;
+};
+
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_SHM_TRANSPORT_HPP
@@ -23,8 +23,19 @@
 #define NDN_TRANSPORT_STREAM_TRANSPORT_HPP
 
 #include "transport.hpp"
+#include "../util/time.hpp"
 
-#include <list>
+#include <boost/chrono/system_clocks.hpp>
+
+#include <algorithm>
+#include <deque>
+
+#include <netinet/tcp.h>
+
+#ifdef NDN_CXX_HAVE_MSG_ZEROCOPY
+#include <sys/socket.h>
+#include <linux/errqueue.h>
+#endif // NDN_CXX_HAVE_MSG_ZEROCOPY
 
 namespace ndn {
 
@@ -34,14 +45,49 @@ class StreamTransportImpl
 public:
   typedef StreamTransportImpl<BaseTransport,Protocol> Impl;
 
-  typedef std::list<Block> BlockSequence;
-  typedef std::list<BlockSequence> TransmissionQueue;
+  /**
+   * @brief Blocks waiting to be written, in order
+   *
+   * The blocks at the front that are part of the write in progress stay in the queue
+   * until the write completes, so that the gathered buffers remain valid.
+   */
+  typedef std::deque<Block> TransmissionQueue;
+
+  /// default limit on the number of bytes gathered into a single write
+  static const size_t DEFAULT_MAX_WRITE_BATCH_BYTES = 64 * 1024;
+  /// default limit on the number of buffers gathered into a single write
+  static const size_t DEFAULT_MAX_WRITE_BATCH_BUFFERS = 64;
+
+  /**
+   * @brief Function setting an option on the socket
+   */
+  typedef function<void(typename Protocol::socket& socket,
+                        boost::system::error_code& error)> SocketOptionSetter;
 
   StreamTransportImpl(BaseTransport& transport, boost::asio::io_service& ioService)
     : m_transport(transport)
+    , m_ioService(ioService)
     , m_socket(ioService)
-    , m_inputBufferSize(0)
+    , m_inputChunk(make_shared<Buffer>(INPUT_CHUNK_SIZE))
+    , m_inputBegin(0)
+    , m_inputEnd(0)
+    , m_busyPollBudget(time::nanoseconds::zero())
+    , m_pollBatchSize(1)
+    , m_isPolling(false)
+    , m_nBlocksInFlight(0)
+    , m_nBytesInFlight(0)
+    , m_maxWriteBatchBytes(DEFAULT_MAX_WRITE_BATCH_BYTES)
+    , m_maxWriteBatchBuffers(DEFAULT_MAX_WRITE_BATCH_BUFFERS)
+    , m_nWrites(0)
+    , m_isCorking(false)
+    , m_isCorked(false)
+    , m_zeroCopyThreshold(0)
+    , m_nZeroCopySends(0)
+    , m_nZeroCopyCompleted(0)
+    , m_nZeroCopySendsBeforeWrite(0)
+    , m_nZeroCopyWrites(0)
     , m_connectionInProgress(false)
+    , m_connectTimeout(time::seconds(4))
     , m_connectTimer(ioService)
   {
   }
@@ -54,13 +100,13 @@ public:
 
     if (!error)
       {
+        // elements decoded on a previous connection are not delivered
+        m_receivedBlocks.clear();
         resume();
         m_transport.m_isConnected = true;
 
         if (!m_transmissionQueue.empty()) {
-          boost::asio::async_write(m_socket, *m_transmissionQueue.begin(),
-                                   bind(&Impl::handleAsyncWrite, this, _1,
-                                        m_transmissionQueue.begin()));
+          asyncWrite();
         }
       }
     else
@@ -82,18 +128,46 @@ public:
     BOOST_THROW_EXCEPTION(Transport::Error(error, "error while connecting to the forwarder"));
   }
 
+  void
+  startConnectTimer()
+  {
+    m_connectTimer.expires_from_now(boost::posix_time::microseconds(
+      time::duration_cast<time::microseconds>(m_connectTimeout).count()));
+    m_connectTimer.async_wait(bind(&Impl::connectTimeoutHandler, this, _1));
+  }
+
+  /**
+   * @brief Set the options of setSocketOption on the socket that has just been opened
+   */
+  void
+  applySocketOptions()
+  {
+    for (const auto& setter : m_socketOptionSetters) {
+      boost::system::error_code error;
+      setter(m_socket, error);
+      if (error) {
+        close();
+        BOOST_THROW_EXCEPTION(Transport::Error(error, "error while setting socket option"));
+      }
+    }
+
+#ifdef NDN_CXX_HAVE_MSG_ZEROCOPY
+    if (m_zeroCopyThreshold > 0) {
+      enableZeroCopy();
+    }
+#endif // NDN_CXX_HAVE_MSG_ZEROCOPY
+  }
+
   void
   connect(const typename Protocol::endpoint& endpoint)
   {
     if (!m_connectionInProgress) {
       m_connectionInProgress = true;
 
-      // Wait at most 4 seconds to connect
-      /// @todo Decide whether this number should be configurable
-      m_connectTimer.expires_from_now(boost::posix_time::seconds(4));
-      m_connectTimer.async_wait(bind(&Impl::connectTimeoutHandler, this, _1));
+      startConnectTimer();
 
-      m_socket.open();
+      m_socket.open(endpoint.protocol());
+      applySocketOptions();
       m_socket.async_connect(endpoint,
                              bind(&Impl::connectHandler, this, _1));
     }
@@ -112,6 +186,16 @@ public:
     m_transport.m_isConnected = false;
     m_transport.m_isExpectingData = false;
     m_transmissionQueue.clear();
+    m_nBlocksInFlight = 0;
+    m_isCorked = false;
+    m_isPolling = false;
+
+    // the kernel drops its references to the pages of zero-copy sends with the socket,
+    // and a new socket numbers its zero-copy sends from zero again
+    m_zeroCopyPending.clear();
+    m_nZeroCopySends = 0;
+    m_nZeroCopyCompleted = 0;
+    m_transport.m_sendQueueMonitor.clear();
   }
 
   void
@@ -139,50 +223,159 @@ public:
     if (!m_transport.m_isExpectingData)
       {
         m_transport.m_isExpectingData = true;
-        m_inputBufferSize = 0;
-        m_socket.async_receive(boost::asio::buffer(m_inputBuffer, MAX_NDN_PACKET_SIZE), 0,
-                               bind(&Impl::handleAsyncReceive, this, _1, _2));
+        if (m_isPolling) {
+          return; // the posted poll continues
+        }
+
+        // drop any partial packet; received bytes may be referenced by Blocks,
+        // so the chunk is only ever appended to
+        m_inputBegin = m_inputEnd;
+        if (INPUT_CHUNK_SIZE - m_inputEnd < MAX_NDN_PACKET_SIZE) {
+          retireInputChunk();
+        }
+        asyncReceive();
       }
   }
 
   void
   send(const Block& wire)
   {
-    BlockSequence sequence;
-    sequence.push_back(wire);
-    m_transmissionQueue.push_back(sequence);
+    m_transmissionQueue.push_back(wire);
+    m_transport.m_sendQueueMonitor.enqueue(wire.size());
+    startWriteIfIdle();
+  }
 
-    if (m_transport.m_isConnected && m_transmissionQueue.size() == 1) {
-      boost::asio::async_write(m_socket, *m_transmissionQueue.begin(),
-                               bind(&Impl::handleAsyncWrite, this, _1,
-                                    m_transmissionQueue.begin()));
-    }
+  /**
+   * @note The header and the payload are accounted as two queued blocks
+   */
+  void
+  send(const Block& header, const Block& payload)
+  {
+    m_transmissionQueue.push_back(header);
+    m_transmissionQueue.push_back(payload);
+    m_transport.m_sendQueueMonitor.enqueue(header.size() + payload.size(), 2);
+    startWriteIfIdle();
+  }
+
+  /**
+   * @brief Limit how much of the transmission queue is gathered into a single write
+   * @param maxBytes the maximum number of bytes per write; a larger block is still
+   *                 written on its own
+   * @param maxBuffers the maximum number of blocks per write, at least 1
+   */
+  void
+  setWriteBatchLimits(size_t maxBytes, size_t maxBuffers)
+  {
+    BOOST_ASSERT(maxBuffers > 0);
+    m_maxWriteBatchBytes = maxBytes;
+    m_maxWriteBatchBuffers = maxBuffers;
+  }
 
-    // if not connected or there is transmission in progress (m_transmissionQueue.size() > 1),
-    // next write will be scheduled either in connectHandler or in asyncWriteHandler
+  /**
+   * @brief Enable or disable busy polling of the socket
+   * @param budget how long to keep spinning with non-blocking receives while no data arrives,
+   *               before waiting in the reactor again; zero disables busy polling
+   *
+   * After a receive completes, each non-blocking receive runs as a separate handler posted
+   * to the io_service, so that timers and other handlers keep running while the thread
+   * spins.  Elements arriving back-to-back are delivered in batches, whose size grows while
+   * the batches fill up and shrinks while the socket runs dry first.
+   */
+  void
+  setBusyPoll(const time::nanoseconds& budget)
+  {
+    m_busyPollBudget = budget;
   }
 
+  /**
+   * @brief Set how long connecting, including name resolution, may take
+   *
+   * Takes effect at the next connect.
+   */
   void
-  send(const Block& header, const Block& payload)
+  setConnectTimeout(const time::nanoseconds& timeout)
+  {
+    m_connectTimeout = timeout;
+  }
+
+  /**
+   * @brief Set @p option on the socket now if it is open, and whenever it is opened
+   *        before connecting
+   *
+   * Options such as the socket buffer sizes only take full effect when set before connecting.
+   *
+   * @throws boost::system::system_error if the open socket does not support @p option
+   */
+  template<typename Option>
+  void
+  setSocketOption(const Option& option)
+  {
+    m_socketOptionSetters.push_back([option] (typename Protocol::socket& socket,
+                                              boost::system::error_code& error) {
+        socket.set_option(option, error);
+      });
+
+    if (m_socket.is_open()) {
+      m_socket.set_option(option);
+    }
+  }
+
+  /**
+   * @brief Enable or disable corking of a TCP socket while the transmission queue
+   *        needs more than one write
+   *
+   * While corked, the kernel sends only full segments, so a burst written with several
+   * gathered writes ends with at most one partial segment.  The socket is uncorked, flushing
+   * that segment, when the queue drains.  Has no effect where TCP_CORK is not available.
+   */
+  void
+  setCorking(bool isEnabled)
   {
-    BlockSequence sequence;
-    sequence.push_back(header);
-    sequence.push_back(payload);
-    m_transmissionQueue.push_back(sequence);
+    m_isCorking = isEnabled;
+    if (!isEnabled && m_isCorked) {
+      setCork(false);
+    }
+  }
 
-    if (m_transport.m_isConnected && m_transmissionQueue.size() == 1) {
-      boost::asio::async_write(m_socket, *m_transmissionQueue.begin(),
-                               bind(&Impl::handleAsyncWrite, this, _1,
-                                    m_transmissionQueue.begin()));
+  /**
+   * @brief Send gathered writes of at least @p nBytes bytes with MSG_ZEROCOPY
+   *
+   * The kernel then transmits from the queued blocks without copying them, and the blocks
+   * are kept until it reports completion on the socket error queue.  This only pays off for
+   * large writes, which requires write batch limits of tens of kilobytes.  Zero disables
+   * zero-copy sends, as does a socket or a platform that does not support them.
+   */
+  void
+  setZeroCopyThreshold(size_t nBytes)
+  {
+#ifdef NDN_CXX_HAVE_MSG_ZEROCOPY
+    m_zeroCopyThreshold = nBytes;
+    if (nBytes > 0 && m_socket.is_open()) {
+      enableZeroCopy();
     }
+#endif // NDN_CXX_HAVE_MSG_ZEROCOPY
+  }
+
+  /**
+   * @return number of gathered writes issued on the socket
+   */
+  size_t
+  getNWrites() const
+  {
+    return m_nWrites;
+  }
 
-    // if not connected or there is transmission in progress (m_transmissionQueue.size() > 1),
-    // next write will be scheduled either in connectHandler or in asyncWriteHandler
+  /**
+   * @return number of gathered writes sent with MSG_ZEROCOPY
+   */
+  size_t
+  getNZeroCopyWrites() const
+  {
+    return m_nZeroCopyWrites;
   }
 
   void
-  handleAsyncWrite(const boost::system::error_code& error,
-                   TransmissionQueue::iterator queueItem)
+  handleAsyncWrite(const boost::system::error_code& error, std::size_t)
   {
     if (error)
       {
@@ -199,29 +392,86 @@ public:
       return; // queue has been already cleared
     }
 
-    m_transmissionQueue.erase(queueItem);
+    completeWrite();
+  }
 
-    if (!m_transmissionQueue.empty()) {
-      boost::asio::async_write(m_socket, *m_transmissionQueue.begin(),
-                               bind(&Impl::handleAsyncWrite, this, _1,
-                                    m_transmissionQueue.begin()));
+#ifdef NDN_CXX_HAVE_MSG_ZEROCOPY
+  void
+  handleZeroCopySend(const boost::system::error_code& error, std::size_t nBytesSent)
+  {
+    if (error == boost::asio::error::no_buffer_space) {
+      // the kernel cannot pin more pages for now, so the rest of the write is copied; the
+      // pages of the earlier sends of this write, if any, are still pinned
+      if (m_nZeroCopySends != m_nZeroCopySendsBeforeWrite) {
+        recordZeroCopyWrite();
+      }
+      boost::asio::async_write(m_socket, m_outputBuffers,
+                               bind(&Impl::handleAsyncWrite, this, _1, _2));
+      return;
+    }
+
+    if (error)
+      {
+        if (error == boost::system::errc::operation_canceled) {
+          return;
+        }
+
+        m_transport.close();
+        BOOST_THROW_EXCEPTION(Transport::Error(error, "error while sending data to socket"));
+      }
+
+    if (!m_transport.m_isConnected) {
+      return;
     }
+
+    // every send that transmits bytes gets the next completion id
+    ++m_nZeroCopySends;
+
+    // a send may be partial, in which case the remaining bytes are sent the same way
+    std::size_t nBytesLeft = nBytesSent;
+    auto sent = m_outputBuffers.begin();
+    while (sent != m_outputBuffers.end() && nBytesLeft >= boost::asio::buffer_size(*sent)) {
+      nBytesLeft -= boost::asio::buffer_size(*sent);
+      ++sent;
+    }
+    m_outputBuffers.erase(m_outputBuffers.begin(), sent);
+    if (!m_outputBuffers.empty()) {
+      m_outputBuffers.front() = m_outputBuffers.front() + nBytesLeft;
+      m_socket.async_send(m_outputBuffers, MSG_ZEROCOPY,
+                          bind(&Impl::handleZeroCopySend, this, _1, _2));
+      return;
+    }
+
+    recordZeroCopyWrite();
+    reapZeroCopyCompletions();
+    completeWrite();
   }
 
-  bool
-  processAll(uint8_t* buffer, size_t& offset, size_t nBytesAvailable)
+  /**
+   * @brief Keep the blocks of the write in progress until its zero-copy sends so far complete
+   */
+  void
+  recordZeroCopyWrite()
   {
-    while (offset < nBytesAvailable) {
-      bool isOk = false;
-      Block element;
-      std::tie(isOk, element) = Block::fromBuffer(buffer + offset, nBytesAvailable - offset);
-      if (!isOk)
-        return false;
+    m_zeroCopyPending.push_back(ZeroCopyWrite{m_nZeroCopySends,
+                                              std::vector<Block>(m_transmissionQueue.begin(),
+                                                                 m_transmissionQueue.begin() +
+                                                                 m_nBlocksInFlight)});
+  }
+#endif // NDN_CXX_HAVE_MSG_ZEROCOPY
 
-      m_transport.receive(element);
-      offset += element.size();
-    }
-    return true;
+  /**
+   * @brief Dispatch every complete TLV element in the unprocessed part of the input chunk
+   *
+   * The elements are delivered to the transport as one batch, after any elements still
+   * pending from busy polling.  The dispatched Blocks share the input chunk instead of
+   * copying the bytes.
+   */
+  void
+  processAll()
+  {
+    decodeAll();
+    dispatchReceivedBlocks();
   }
 
   void
@@ -238,51 +488,386 @@ public:
         BOOST_THROW_EXCEPTION(Transport::Error(error, "error while receiving data from socket"));
       }
 
-    m_inputBufferSize += nBytesRecvd;
-    // do magic
+#ifdef NDN_CXX_HAVE_MSG_ZEROCOPY
+    if (!m_zeroCopyPending.empty()) {
+      reapZeroCopyCompletions();
+    }
+#endif // NDN_CXX_HAVE_MSG_ZEROCOPY
+
+    m_inputEnd += nBytesRecvd;
+
+    processAll();
+    checkInputBuffer();
+
+    if (INPUT_CHUNK_SIZE - m_inputEnd < MAX_NDN_PACKET_SIZE) {
+      retireInputChunk();
+    }
+
+    if (m_busyPollBudget > time::nanoseconds::zero() && m_transport.m_isExpectingData) {
+      m_isPolling = true;
+      m_busyPollDeadline = boost::chrono::steady_clock::now() + m_busyPollBudget;
+      m_ioService.post(bind(&Impl::pollReceive, this));
+    }
+    else {
+      asyncReceive();
+    }
+  }
+
+  /**
+   * @brief Try one non-blocking receive, then post the next one or return to the reactor
+   */
+  void
+  pollReceive()
+  {
+    if (!m_transport.m_isExpectingData) {
+      // paused or closed; resume() restarts receiving
+      m_isPolling = false;
+      if (m_transport.m_isConnected) {
+        // the pending batch was received before pause(), like the rest of a read
+        // that is delivered by processAll
+        dispatchReceivedBlocks();
+      }
+      return;
+    }
+
+    if (!m_socket.non_blocking()) {
+      m_socket.non_blocking(true);
+    }
+
+    boost::system::error_code error;
+    size_t nBytesRecvd = m_socket.receive(boost::asio::buffer(m_inputChunk->buf() + m_inputEnd,
+                                                              INPUT_CHUNK_SIZE - m_inputEnd),
+                                          0, error);
+    auto now = boost::chrono::steady_clock::now();
+
+    if (error == boost::asio::error::would_block) {
+      if (!m_receivedBlocks.empty()) {
+        // the socket ran dry before the batch filled up
+        if (m_receivedBlocks.size() < m_pollBatchSize / 2) {
+          m_pollBatchSize /= 2;
+        }
+        dispatchReceivedBlocks();
+      }
+
+      if (!m_transport.m_isExpectingData) {
+        m_isPolling = false;
+      }
+      else if (now >= m_busyPollDeadline) {
+        m_isPolling = false;
+        asyncReceive();
+      }
+      else {
+        m_ioService.post(bind(&Impl::pollReceive, this));
+      }
+      return;
+    }
+
+    if (error) {
+      m_isPolling = false;
+      m_transport.close();
+      BOOST_THROW_EXCEPTION(Transport::Error(error, "error while receiving data from socket"));
+    }
+
+    m_inputEnd += nBytesRecvd;
+    decodeAll();
+    checkInputBuffer();
+    m_busyPollDeadline = now + m_busyPollBudget;
+
+    if (m_receivedBlocks.size() >= m_pollBatchSize) {
+      m_pollBatchSize = std::min(2 * m_pollBatchSize, MAX_POLL_BATCH_SIZE);
+      dispatchReceivedBlocks();
+    }
+
+    if (INPUT_CHUNK_SIZE - m_inputEnd < MAX_NDN_PACKET_SIZE) {
+      retireInputChunk();
+    }
+    m_ioService.post(bind(&Impl::pollReceive, this));
+  }
+
+private:
+  /**
+   * @brief Append every complete TLV element in the unprocessed part of the input chunk
+   *        to the pending batch
+   */
+  void
+  decodeAll()
+  {
+    while (m_inputBegin < m_inputEnd) {
+      bool isOk = false;
+      Block element;
+      std::tie(isOk, element) = Block::fromBuffer(m_inputChunk, m_inputBegin,
+                                                  m_inputEnd - m_inputBegin);
+      if (!isOk)
+        break;
+
+      m_inputBegin += element.size();
+      m_receivedBlocks.push_back(element);
+    }
+  }
+
+  void
+  dispatchReceivedBlocks()
+  {
+    if (!m_receivedBlocks.empty()) {
+      m_transport.receive(m_receivedBlocks);
+      m_receivedBlocks.clear();
+    }
+  }
 
-    std::size_t offset = 0;
-    bool hasProcessedSome = processAll(m_inputBuffer, offset, m_inputBufferSize);
-    if (!hasProcessedSome && m_inputBufferSize == MAX_NDN_PACKET_SIZE && offset == 0)
+  void
+  checkInputBuffer()
+  {
+    if (m_inputEnd - m_inputBegin >= MAX_NDN_PACKET_SIZE)
       {
+        m_isPolling = false;
         m_transport.close();
         BOOST_THROW_EXCEPTION(Transport::Error(boost::system::error_code(),
                                                "input buffer full, but a valid TLV cannot be "
                                                "decoded"));
       }
+  }
 
-    if (offset > 0)
-      {
-        if (offset != m_inputBufferSize)
-          {
-            std::copy(m_inputBuffer + offset, m_inputBuffer + m_inputBufferSize,
-                      m_inputBuffer);
-            m_inputBufferSize -= offset;
-          }
-        else
-          {
-            m_inputBufferSize = 0;
-          }
+  void
+  startWriteIfIdle()
+  {
+    // if not connected or there is transmission in progress,
+    // next write will be scheduled either in connectHandler or in handleAsyncWrite
+    if (m_transport.m_isConnected && m_nBlocksInFlight == 0) {
+      asyncWrite();
+    }
+  }
+
+  /**
+   * @brief Write as many queued blocks as the batch limits allow with one gathered write
+   */
+  void
+  asyncWrite()
+  {
+    BOOST_ASSERT(m_nBlocksInFlight == 0 && !m_transmissionQueue.empty());
+
+    m_outputBuffers.clear();
+    size_t nBytes = 0;
+    for (const Block& block : m_transmissionQueue) {
+      if (m_outputBuffers.size() == m_maxWriteBatchBuffers ||
+          (!m_outputBuffers.empty() && nBytes + block.size() > m_maxWriteBatchBytes))
+        break;
+
+      m_outputBuffers.push_back(boost::asio::const_buffer(block.wire(), block.size()));
+      nBytes += block.size();
+    }
+    m_nBlocksInFlight = m_outputBuffers.size();
+    m_nBytesInFlight = nBytes;
+    ++m_nWrites;
+
+    if (m_isCorking && !m_isCorked && m_nBlocksInFlight < m_transmissionQueue.size()) {
+      setCork(true);
+    }
+
+#ifdef NDN_CXX_HAVE_MSG_ZEROCOPY
+    if (m_zeroCopyThreshold > 0 && nBytes >= m_zeroCopyThreshold) {
+      ++m_nZeroCopyWrites;
+      m_nZeroCopySendsBeforeWrite = m_nZeroCopySends;
+      m_socket.async_send(m_outputBuffers, MSG_ZEROCOPY,
+                          bind(&Impl::handleZeroCopySend, this, _1, _2));
+      return;
+    }
+#endif // NDN_CXX_HAVE_MSG_ZEROCOPY
+
+    boost::asio::async_write(m_socket, m_outputBuffers,
+                             bind(&Impl::handleAsyncWrite, this, _1, _2));
+  }
+
+  /**
+   * @brief Release the blocks of the write that completed, and start the next write
+   */
+  void
+  completeWrite()
+  {
+    m_transmissionQueue.erase(m_transmissionQueue.begin(),
+                              m_transmissionQueue.begin() + m_nBlocksInFlight);
+    m_transport.m_sendQueueMonitor.dequeue(m_nBytesInFlight, m_nBlocksInFlight);
+    m_nBlocksInFlight = 0;
+
+    if (!m_transmissionQueue.empty()) {
+      asyncWrite();
+    }
+    else if (m_isCorked) {
+      setCork(false);
+    }
+  }
+
+  void
+  setCork(bool isCorked)
+  {
+#ifdef TCP_CORK
+    boost::system::error_code error; // corking is only an optimization
+    m_socket.set_option(boost::asio::detail::socket_option::boolean<IPPROTO_TCP,
+                                                                    TCP_CORK>(isCorked),
+                        error);
+#endif // TCP_CORK
+    m_isCorked = isCorked;
+  }
+
+#ifdef NDN_CXX_HAVE_MSG_ZEROCOPY
+  void
+  enableZeroCopy()
+  {
+    boost::system::error_code error;
+    m_socket.set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET,
+                                                                    SO_ZEROCOPY>(true),
+                        error);
+    if (error) {
+      m_zeroCopyThreshold = 0; // e.g., a kernel older than 4.14 or a Unix socket
+    }
+  }
+
+  /**
+   * @brief Read the completion notifications of zero-copy sends from the socket error
+   *        queue, and release the blocks the kernel no longer uses
+   */
+  void
+  reapZeroCopyCompletions()
+  {
+    while (true) {
+      uint8_t control[CMSG_SPACE(sizeof(sock_extended_err)) + 64];
+      msghdr message = {};
+      message.msg_control = control;
+      message.msg_controllen = sizeof(control);
+      if (::recvmsg(m_socket.native_handle(), &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+        break;
+
+      for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr;
+           header = CMSG_NXTHDR(&message, header)) {
+        const sock_extended_err* notification =
+          reinterpret_cast<const sock_extended_err*>(CMSG_DATA(header));
+        if (notification->ee_errno == 0 && notification->ee_origin == SO_EE_ORIGIN_ZEROCOPY) {
+          // sends [ee_info, ee_data] have completed; TCP reports them in order
+          m_nZeroCopyCompleted = notification->ee_data + 1;
+        }
       }
+    }
+
+    while (!m_zeroCopyPending.empty() &&
+           static_cast<int32_t>(m_nZeroCopyCompleted - m_zeroCopyPending.front().nSends) >= 0) {
+      m_zeroCopyPending.pop_front();
+    }
+  }
+#endif // NDN_CXX_HAVE_MSG_ZEROCOPY
 
-    m_socket.async_receive(boost::asio::buffer(m_inputBuffer + m_inputBufferSize,
-                                               MAX_NDN_PACKET_SIZE - m_inputBufferSize), 0,
+  void
+  asyncReceive()
+  {
+    m_socket.async_receive(boost::asio::buffer(m_inputChunk->buf() + m_inputEnd,
+                                               INPUT_CHUNK_SIZE - m_inputEnd), 0,
                            bind(&Impl::handleAsyncReceive, this, _1, _2));
   }
 
+  /**
+   * @brief Continue receiving into a fresh chunk, moving the partial trailing packet there
+   *
+   * A retired chunk is reused once no Block references it anymore.
+   */
+  void
+  retireInputChunk()
+  {
+    BufferPtr chunk;
+    auto reusable = std::find_if(m_retiredChunks.begin(), m_retiredChunks.end(),
+                                 [] (const BufferPtr& retired) {
+                                   return retired.use_count() == 1;
+                                 });
+    if (reusable != m_retiredChunks.end()) {
+      chunk = *reusable;
+      m_retiredChunks.erase(reusable);
+    }
+    else {
+      chunk = make_shared<Buffer>(INPUT_CHUNK_SIZE);
+    }
+
+    std::copy(m_inputChunk->begin() + m_inputBegin, m_inputChunk->begin() + m_inputEnd,
+              chunk->begin());
+    m_inputEnd -= m_inputBegin;
+    m_inputBegin = 0;
+
+    if (m_retiredChunks.size() >= MAX_RETIRED_CHUNKS) {
+      // still referenced by Blocks; released with the last of them
+      m_retiredChunks.erase(m_retiredChunks.begin());
+    }
+    m_retiredChunks.push_back(m_inputChunk);
+    m_inputChunk = chunk;
+  }
+
 protected:
   BaseTransport& m_transport;
+  boost::asio::io_service& m_ioService;
 
   typename Protocol::socket m_socket;
-  uint8_t m_inputBuffer[MAX_NDN_PACKET_SIZE];
-  size_t m_inputBufferSize;
+
+  /// received Blocks share their chunk, see Transport::ReceiveCallback
+  static const size_t INPUT_CHUNK_SIZE = 8 * MAX_NDN_PACKET_SIZE;
+  static const size_t MAX_RETIRED_CHUNKS = 4;
+
+  BufferPtr m_inputChunk;
+  size_t m_inputBegin; ///< start of the received bytes not yet dispatched
+  size_t m_inputEnd;   ///< end of the received bytes
+  std::vector<BufferPtr> m_retiredChunks;
+  std::vector<Block> m_receivedBlocks; ///< batch being gathered or dispatched
+
+  static const size_t MAX_POLL_BATCH_SIZE = 64;
+
+  time::nanoseconds m_busyPollBudget;
+  boost::chrono::steady_clock::time_point m_busyPollDeadline;
+  size_t m_pollBatchSize; ///< number of elements after which a busy-polled batch is delivered
+  bool m_isPolling;
 
   TransmissionQueue m_transmissionQueue;
+  std::vector<boost::asio::const_buffer> m_outputBuffers; ///< gather list of the write in progress
+  size_t m_nBlocksInFlight; ///< number of queued blocks in the write in progress
+  size_t m_nBytesInFlight;
+  size_t m_maxWriteBatchBytes;
+  size_t m_maxWriteBatchBuffers;
+  size_t m_nWrites;
+
+  std::vector<SocketOptionSetter> m_socketOptionSetters;
+  bool m_isCorking;
+  bool m_isCorked;
+
+  /**
+   * @brief Blocks of a zero-copy write, kept until the kernel completes its last send
+   */
+  struct ZeroCopyWrite
+  {
+    uint32_t nSends; ///< number of zero-copy sends up to and including this write
+    std::vector<Block> blocks;
+  };
+
+  size_t m_zeroCopyThreshold;
+  uint32_t m_nZeroCopySends;
+  uint32_t m_nZeroCopyCompleted; ///< zero-copy sends reported complete, in order
+  uint32_t m_nZeroCopySendsBeforeWrite; ///< value of m_nZeroCopySends when the write started
+  std::deque<ZeroCopyWrite> m_zeroCopyPending;
+  size_t m_nZeroCopyWrites;
+
   bool m_connectionInProgress;
+  time::nanoseconds m_connectTimeout;
 
   boost::asio::deadline_timer m_connectTimer;
 };
 
+template<class BaseTransport, class Protocol>
+const size_t StreamTransportImpl<BaseTransport, Protocol>::INPUT_CHUNK_SIZE;
+
+template<class BaseTransport, class Protocol>
+const size_t StreamTransportImpl<BaseTransport, Protocol>::MAX_RETIRED_CHUNKS;
+
+template<class BaseTransport, class Protocol>
+const size_t StreamTransportImpl<BaseTransport, Protocol>::MAX_POLL_BATCH_SIZE;
+
+template<class BaseTransport, class Protocol>
+const size_t StreamTransportImpl<BaseTransport, Protocol>::DEFAULT_MAX_WRITE_BATCH_BYTES;
+
+template<class BaseTransport, class Protocol>
+const size_t StreamTransportImpl<BaseTransport, Protocol>::DEFAULT_MAX_WRITE_BATCH_BUFFERS;
+
 
 template<class BaseTransport, class Protocol>
 class StreamTransportWithResolverImpl : public StreamTransportImpl<BaseTransport, Protocol>
@@ -315,6 +900,15 @@ public:
         BOOST_THROW_EXCEPTION(Transport::Error(error, "Unable to resolve because host or port"));
       }
 
+    boost::system::error_code openError;
+    this->m_socket.open(endpoint->endpoint().protocol(), openError);
+    if (openError)
+      {
+        this->m_transport.close();
+        BOOST_THROW_EXCEPTION(Transport::Error(openError, "error while opening socket"));
+      }
+    this->applySocketOptions();
+
     this->m_socket.async_connect(*endpoint,
                                  bind(&Impl::connectHandler, this, _1));
   }
@@ -325,14 +919,11 @@ public:
     if (!this->m_connectionInProgress) {
       this->m_connectionInProgress = true;
 
-      // Wait at most 4 seconds to connect
-      /// @todo Decide whether this number should be configurable
-      this->m_connectTimer.expires_from_now(boost::posix_time::seconds(4));
-      this->m_connectTimer.async_wait(bind(&Impl::connectTimeoutHandler, this, _1));
+      this->startConnectTimer();
 
       // typename boost::asio::ip::basic_resolver< Protocol > resolver;
       shared_ptr<typename Protocol::resolver> resolver =
-        make_shared<typename Protocol::resolver>(ref(this->m_socket.get_io_service()));
+        make_shared<typename Protocol::resolver>(this->m_ioService);
 
       resolver->async_resolve(query, bind(&Impl::resolveHandler, this, _1, _2, resolver));
     }
@@ -27,9 +27,35 @@
 
 namespace ndn {
 
-TcpTransport::TcpTransport(const std::string& host, const std::string& port/* = "6363"*/)
+/**
+ * @brief Set @p value to the field @p key if it is present
+ * @throws boost::property_tree::ptree_bad_data if the field cannot be converted
+ */
+template<typename T>
+static void
+getOptionalField(const ConfigFile::Parsed& parsed, const std::string& key, T& value)
+{
+  if (parsed.get_child_optional(key)) {
+    value = parsed.get<T>(key);
+  }
+}
+
+TcpTransport::Options::Options()
+  : noDelay(true)
+  , cork(false)
+  , sendBufferSize(0)
+  , receiveBufferSize(0)
+  , connectTimeout(time::seconds(4))
+  , zeroCopyThreshold(0)
+  , writeBatchSize(0)
+{
+}
+
+TcpTransport::TcpTransport(const std::string& host, const std::string& port/* = "6363"*/,
+                           const Options& options/* = Options()*/)
   : m_host(host)
   , m_port(port)
+  , m_options(options)
 {
 }
 
@@ -41,7 +67,8 @@ shared_ptr<TcpTransport>
 TcpTransport::create(const ConfigFile& config)
 {
   const auto hostAndPort(getDefaultSocketHostAndPort(config));
-  return make_shared<TcpTransport>(hostAndPort.first, hostAndPort.second);
+  return make_shared<TcpTransport>(hostAndPort.first, hostAndPort.second,
+                                   getDefaultOptions(config));
 }
 
 std::pair<std::string, std::string>
@@ -76,6 +103,35 @@ TcpTransport::getDefaultSocketHostAndPort(const ConfigFile& config)
   return {host, port};
 }
 
+TcpTransport::Options
+TcpTransport::getDefaultOptions(const ConfigFile& config)
+{
+  const ConfigFile::Parsed& parsed = config.getParsedConfiguration();
+
+  Options options;
+  try {
+    getOptionalField(parsed, "tcp_nodelay", options.noDelay);
+    getOptionalField(parsed, "tcp_cork", options.cork);
+    getOptionalField(parsed, "tcp_sndbuf", options.sendBufferSize);
+    getOptionalField(parsed, "tcp_rcvbuf", options.receiveBufferSize);
+    time::milliseconds::rep connectTimeout = options.connectTimeout.count();
+    getOptionalField(parsed, "tcp_connect_timeout", connectTimeout);
+    options.connectTimeout = time::milliseconds(connectTimeout);
+    getOptionalField(parsed, "tcp_zerocopy_threshold", options.zeroCopyThreshold);
+    getOptionalField(parsed, "tcp_write_batch_size", options.writeBatchSize);
+  }
+  catch (const boost::property_tree::ptree_bad_data& error) {
+    BOOST_THROW_EXCEPTION(ConfigFile::Error("Invalid value \"" + error.data<std::string>() +
+                                            "\" of a tcp_* field"));
+  }
+
+  if (options.connectTimeout <= time::milliseconds::zero()) {
+    BOOST_THROW_EXCEPTION(ConfigFile::Error("tcp_connect_timeout must be positive"));
+  }
+
+  return options;
+}
+
 void
 TcpTransport::connect(boost::asio::io_service& ioService,
                       const ReceiveCallback& receiveCallback)
@@ -84,6 +140,22 @@ TcpTransport::connect(boost::asio::io_service& ioService,
     Transport::connect(ioService, receiveCallback);
 
     m_impl = make_shared<Impl>(ref(*this), ref(ioService));
+
+    m_impl->setSocketOption(boost::asio::ip::tcp::no_delay(m_options.noDelay));
+    if (m_options.sendBufferSize > 0) {
+      m_impl->setSocketOption(
+        boost::asio::socket_base::send_buffer_size(m_options.sendBufferSize));
+    }
+    if (m_options.receiveBufferSize > 0) {
+      m_impl->setSocketOption(
+        boost::asio::socket_base::receive_buffer_size(m_options.receiveBufferSize));
+    }
+    m_impl->setCorking(m_options.cork);
+    m_impl->setZeroCopyThreshold(m_options.zeroCopyThreshold);
+    m_impl->setConnectTimeout(m_options.connectTimeout);
+    if (m_options.writeBatchSize > 0) {
+      m_impl->setWriteBatchLimits(m_options.writeBatchSize, Impl::DEFAULT_MAX_WRITE_BATCH_BUFFERS);
+    }
   }
 
   boost::asio::ip::tcp::resolver::query query(m_host, m_port);
@@ -25,6 +25,7 @@
 #include "../common.hpp"
 #include "transport.hpp"
 #include "../util/config-file.hpp"
+#include "../util/time.hpp"
 
 
 // forward declaration
@@ -39,9 +40,56 @@ template<class T, class U> class StreamTransportWithResolverImpl;
 class TcpTransport : public Transport
 {
 public:
-  TcpTransport(const std::string& host, const std::string& port = "6363");
+  /**
+   * @brief Socket and batching options of a TCP transport
+   *
+   * The options are applied to the socket before each connect.
+   */
+  struct Options
+  {
+    Options();
+
+    /// disable Nagle's algorithm (TCP_NODELAY)
+    bool noDelay;
+
+    /**
+     * @brief cork the socket (TCP_CORK) while the send queue needs more than one write,
+     *        so that a burst ends with at most one partial segment
+     */
+    bool cork;
+
+    /// size of the kernel send buffer (SO_SNDBUF), zero to keep the system default
+    size_t sendBufferSize;
+
+    /// size of the kernel receive buffer (SO_RCVBUF), zero to keep the system default
+    size_t receiveBufferSize;
+
+    /// how long resolving the host and connecting may take
+    time::milliseconds connectTimeout;
+
+    /**
+     * @brief minimum size of a gathered write sent with MSG_ZEROCOPY, zero to disable
+     *
+     * Ignored where MSG_ZEROCOPY is not supported.
+     */
+    size_t zeroCopyThreshold;
+
+    /// maximum number of bytes gathered into one write, zero to keep the default
+    size_t writeBatchSize;
+  };
+
+  TcpTransport(const std::string& host, const std::string& port = "6363",
+               const Options& options = Options());
   ~TcpTransport();
 
+  const Options&
+  getOptions() const
+  {
+    return m_options;
+  }
+
+  using Transport::connect;
+
   // from Transport
   virtual void
   connect(boost::asio::io_service& ioService,
@@ -70,9 +118,20 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   static std::pair<std::string, std::string>
   getDefaultSocketHostAndPort(const ConfigFile& config);
 
+  /**
+   * @brief Determine the transport options from the tcp_* fields of the configuration
+   *
+   * Omitted fields keep their default values.
+   *
+   * @throws ConfigFile::Error if a present field has an invalid value
+   */
+  static Options
+  getDefaultOptions(const ConfigFile& config);
+
 private:
   std::string m_host;
   std::string m_port;
+  Options m_options;
 
   typedef StreamTransportWithResolverImpl<TcpTransport, boost::asio::ip::tcp> Impl;
   friend class StreamTransportImpl<TcpTransport, boost::asio::ip::tcp>;
@@ -24,6 +24,7 @@
 
 #include "../common.hpp"
 #include "../encoding/block.hpp"
+#include "send-queue-monitor.hpp"
 
 #include <boost/asio.hpp>
 
@@ -39,7 +40,23 @@ public:
     inline Error(const std::string& msg);
   };
 
+  /**
+   * @brief Callback receiving one packet
+   *
+   * A stream transport slices received packets out of a shared input chunk of
+   * 8 * MAX_NDN_PACKET_SIZE bytes, so a Block that is kept after the callback returns keeps
+   * that whole chunk allocated.  A receiver that retains packets for long, e.g. in a cache,
+   * should keep a copy with a buffer of its own, such as Block(wire.wire(), wire.size()).
+   */
   typedef function<void (const Block& wire)> ReceiveCallback;
+
+  /**
+   * @brief Callback receiving, in order, all packets decoded from one read of the connection
+   *
+   * The vector may be reused after the callback returns; the Blocks themselves can be kept,
+   * with the same effect on the input chunk as described for ReceiveCallback.
+   */
+  typedef function<void (const std::vector<Block>& wires)> BatchReceiveCallback;
   typedef function<void ()> ErrorCallback;
 
   inline
@@ -57,6 +74,18 @@ public:
   connect(boost::asio::io_service& io_service,
           const ReceiveCallback& receiveCallback);
 
+  /**
+   * @brief Connect transport, delivering the packets of each read with a single callback
+   *
+   * The per-packet connect() is an adapter that invokes receiveCallback for each packet
+   * of the batch.
+   *
+   * @throws boost::system::system_error if connection cannot be established
+   */
+  inline void
+  connect(boost::asio::io_service& io_service,
+          const BatchReceiveCallback& batchReceiveCallback);
+
   /**
    * @brief Close the connection.
    */
@@ -92,15 +121,33 @@ public:
   inline bool
   isExpectingData();
 
+  /**
+   * @brief Get the accounting of the blocks queued for sending and not yet written out
+   *
+   * Watermarks and a writability callback can be set on the returned monitor to pause
+   * the producer while the queue is too deep.  Closing the transport empties the queue.
+   */
+  inline SendQueueMonitor&
+  getSendQueueMonitor();
+
 protected:
   inline void
   receive(const Block& wire);
 
+  inline void
+  receive(const std::vector<Block>& wires);
+
+private:
+  inline void
+  receiveEach(const std::vector<Block>& wires);
+
 protected:
   boost::asio::io_service* m_ioService;
   bool m_isConnected;
   bool m_isExpectingData;
   ReceiveCallback m_receiveCallback;
+  BatchReceiveCallback m_batchReceiveCallback;
+  SendQueueMonitor m_sendQueueMonitor;
 };
 
 inline
@@ -134,6 +181,15 @@ Transport::connect(boost::asio::io_service& ioService,
 {
   m_ioService = &ioService;
   m_receiveCallback = receiveCallback;
+  m_batchReceiveCallback = bind(&Transport::receiveEach, this, _1);
+}
+
+inline void
+Transport::connect(boost::asio::io_service& ioService,
+                   const BatchReceiveCallback& batchReceiveCallback)
+{
+  this->connect(ioService, ReceiveCallback());
+  m_batchReceiveCallback = batchReceiveCallback;
 }
 
 inline bool
@@ -148,10 +204,33 @@ Transport::isExpectingData()
   return m_isExpectingData;
 }
 
+inline SendQueueMonitor&
+Transport::getSendQueueMonitor()
+{
+  return m_sendQueueMonitor;
+}
+
 inline void
 Transport::receive(const Block& wire)
 {
-  m_receiveCallback(wire);
+  if (static_cast<bool>(m_receiveCallback))
+    m_receiveCallback(wire);
+  else
+    m_batchReceiveCallback(std::vector<Block>{wire});
+}
+
+inline void
+Transport::receive(const std::vector<Block>& wires)
+{
+  m_batchReceiveCallback(wires);
+}
+
+inline void
+Transport::receiveEach(const std::vector<Block>& wires)
+{
+  for (const Block& wire : wires) {
+    m_receiveCallback(wire);
+  }
 }
 
 } // namespace ndn
@@ -31,6 +31,7 @@ namespace ndn {
 
 UnixTransport::UnixTransport(const std::string& unixSocket)
   : m_unixSocket(unixSocket)
+  , m_busyPollBudget(time::nanoseconds::zero())
 {
 }
 
@@ -89,6 +90,7 @@ UnixTransport::connect(boost::asio::io_service& ioService,
     Transport::connect(ioService, receiveCallback);
 
     m_impl = make_shared<Impl>(ref(*this), ref(ioService));
+    m_impl->setBusyPoll(m_busyPollBudget);
   }
 
   m_impl->connect(boost::asio::local::stream_protocol::endpoint(m_unixSocket));
@@ -108,6 +110,15 @@ UnixTransport::send(const Block& header, const Block& payload)
   m_impl->send(header, payload);
 }
 
+void
+UnixTransport::setBusyPoll(const time::nanoseconds& budget)
+{
+  m_busyPollBudget = budget;
+  if (static_cast<bool>(m_impl)) {
+    m_impl->setBusyPoll(budget);
+  }
+}
+
 void
 UnixTransport::close()
 {
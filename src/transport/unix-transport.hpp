@@ -25,6 +25,7 @@
 #include "../common.hpp"
 #include "transport.hpp"
 #include "../util/config-file.hpp"
+#include "../util/time.hpp"
 
 // forward declaration
 namespace boost { namespace asio { namespace local { class stream_protocol; } } }
@@ -49,6 +50,8 @@ public:
 
   ~UnixTransport();
 
+  using Transport::connect;
+
   // from Transport
   virtual void
   connect(boost::asio::io_service& ioService,
@@ -69,6 +72,18 @@ public:
   virtual void
   send(const Block& header, const Block& payload);
 
+  /**
+   * @brief Enable or disable busy polling of the socket (disabled by default)
+   * @param budget how long to keep spinning with non-blocking receives while no data arrives,
+   *               before waiting in the reactor again; zero disables busy polling
+   *
+   * Busy polling trades CPU time for lower receive latency: the thread never sleeps while
+   * packets arrive more often than @p budget, and back-to-back packets are delivered in
+   * batches of adaptive size.
+   */
+  void
+  setBusyPoll(const time::nanoseconds& budget);
+
   static shared_ptr<UnixTransport>
   create(const ConfigFile& config);
 
@@ -84,6 +99,7 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
 private:
   std::string m_unixSocket;
+  time::nanoseconds m_busyPollBudget;
 
   typedef StreamTransportImpl<UnixTransport, boost::asio::local::stream_protocol> Impl;
   friend class StreamTransportImpl<UnixTransport, boost::asio::local::stream_protocol>;
@@ -0,0 +1,206 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#include "callback-profiler.hpp"
+
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <ostream>
+
+namespace ndn {
+namespace util {
+
+CallbackProfiler::Scope::Scope(CallbackType type, const Name& name)
+  : m_type(type)
+  , m_name(name)
+  , m_prefix(nullptr)
+  , m_simulatedTime(time::steady_clock::now())
+  , m_start(boost::chrono::steady_clock::now())
+{
+}
+
+CallbackProfiler::Scope::Scope(CallbackType type, const Name& name, const Name& prefix)
+  : m_type(type)
+  , m_name(name)
+  , m_prefix(&prefix)
+  , m_simulatedTime(time::steady_clock::now())
+  , m_start(boost::chrono::steady_clock::now())
+{
+}
+
+CallbackProfiler::Scope::~Scope()
+{
+  time::nanoseconds duration = boost::chrono::steady_clock::now() - m_start;
+  static const Name EMPTY_PREFIX;
+  CallbackProfiler::getInstance().record(m_type, m_name,
+                                         m_prefix != nullptr ? *m_prefix : EMPTY_PREFIX,
+                                         m_simulatedTime, duration);
+}
+
+CallbackProfiler&
+CallbackProfiler::getInstance()
+{
+  static CallbackProfiler instance;
+  return instance;
+}
+
+CallbackProfiler::CallbackProfiler()
+  : m_prefixLength(2)
+  , m_nSlowestCalls(5)
+  , m_isTraceEnabled(false)
+  , m_maxTracedCalls(0)
+{
+}
+
+void
+CallbackProfiler::record(CallbackType type, const Name& name, const Name& prefix,
+                         const time::steady_clock::TimePoint& simulatedTime,
+                         const time::nanoseconds& wallDuration)
+{
+  Call call{name, ns3::Simulator::GetContext(), simulatedTime, wallDuration};
+
+  Entry& entry = m_profile[{type, prefix.empty() ? name.getPrefix(static_cast<ssize_t>(m_prefixLength)) : prefix}];
+  ++entry.nCalls;
+  entry.totalWallDuration += wallDuration;
+  entry.maxWallDuration = std::max(entry.maxWallDuration, wallDuration);
+
+  auto position = std::find_if(entry.slowestCalls.begin(), entry.slowestCalls.end(),
+                               [&] (const Call& slowCall) {
+                                 return slowCall.wallDuration < wallDuration;
+                               });
+  if (static_cast<size_t>(position - entry.slowestCalls.begin()) < m_nSlowestCalls) {
+    entry.slowestCalls.insert(position, call);
+    if (entry.slowestCalls.size() > m_nSlowestCalls) {
+      entry.slowestCalls.pop_back();
+    }
+  }
+
+  if (m_isTraceEnabled && m_trace.size() < m_maxTracedCalls) {
+    m_trace.push_back({type, std::move(call)});
+  }
+}
+
+void
+CallbackProfiler::reset()
+{
+  m_profile.clear();
+  m_trace.clear();
+}
+
+void
+CallbackProfiler::enableTrace(size_t maxCalls)
+{
+  m_isTraceEnabled = true;
+  m_maxTracedCalls = maxCalls;
+}
+
+void
+CallbackProfiler::disableTrace()
+{
+  m_isTraceEnabled = false;
+}
+
+void
+CallbackProfiler::printFlatProfile(std::ostream& os) const
+{
+  std::vector<Profile::const_iterator> entries;
+  for (auto entry = m_profile.begin(); entry != m_profile.end(); ++entry) {
+    entries.push_back(entry);
+  }
+  std::sort(entries.begin(), entries.end(),
+            [] (Profile::const_iterator a, Profile::const_iterator b) {
+              return a->second.totalWallDuration > b->second.totalWallDuration;
+            });
+
+  for (auto entry : entries) {
+    const Entry& stats = entry->second;
+    os << entry->first.first << " " << entry->first.second
+       << " calls=" << stats.nCalls
+       << " total=" << stats.totalWallDuration.count()
+       << " mean=" << stats.totalWallDuration.count() / static_cast<int64_t>(stats.nCalls)
+       << " max=" << stats.maxWallDuration.count() << " (ns)\n";
+    for (const Call& call : stats.slowestCalls) {
+      os << "  " << call.wallDuration.count() << "ns " << call.name
+         << " at " << call.simulatedTime.time_since_epoch().count() << "ns"
+         << " on context " << call.context << "\n";
+    }
+  }
+}
+
+static void
+writeJsonString(std::ostream& os, const std::string& value)
+{
+  os << '"';
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20) {
+      os << ' ';
+    }
+    else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+void
+CallbackProfiler::writeChromeTrace(std::ostream& os) const
+{
+  os << "{\"traceEvents\":[";
+  bool isFirst = true;
+  for (const auto& traced : m_trace) {
+    const Call& call = traced.second;
+    if (!isFirst) {
+      os << ",";
+    }
+    isFirst = false;
+
+    // timestamps and durations are in microseconds
+    os << "\n{\"name\":";
+    writeJsonString(os, call.name.toUri());
+    os << ",\"cat\":\"" << traced.first << "\",\"ph\":\"X\""
+       << ",\"ts\":" << call.simulatedTime.time_since_epoch().count() / 1000.0
+       << ",\"dur\":" << call.wallDuration.count() / 1000.0
+       << ",\"pid\":0,\"tid\":" << call.context << "}";
+  }
+  os << "\n]}\n";
+}
+
+std::ostream&
+operator<<(std::ostream& os, CallbackProfiler::CallbackType type)
+{
+  switch (type) {
+  case CallbackProfiler::ON_DATA:
+    return os << "OnData";
+  case CallbackProfiler::ON_TIMEOUT:
+    return os << "OnTimeout";
+  case CallbackProfiler::ON_INTEREST:
+    return os << "OnInterest";
+  }
+  return os << static_cast<int>(type);
+}
+
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#ifndef NDN_UTIL_CALLBACK_PROFILER_HPP
+#define NDN_UTIL_CALLBACK_PROFILER_HPP
+
+#include "../common.hpp"
+#include "../name.hpp"
+#include "time.hpp"
+
+#include <boost/chrono/system_clocks.hpp>
+
+#include <map>
+
+namespace ndn {
+namespace util {
+
+/**
+ * @brief Records the time spent in the OnData, OnTimeout and OnInterest callbacks of Faces
+ *
+ * The library calls the profiler around every callback only when it is configured with
+ * --with-callback-profiling, which defines NDN_CXX_WITH_CALLBACK_PROFILING; otherwise the
+ * hooks are compiled out and nothing is recorded.
+ *
+ * Calls are aggregated per callback type and name prefix: the InterestFilter prefix for
+ * OnInterest, and the first getPrefixLength() components of the Interest name for OnData
+ * and OnTimeout.  For each prefix, the profiler keeps the number of calls, the total and
+ * maximum wall-clock time, and the slowest calls.  When tracing is enabled, every call is
+ * also recorded so that it can be exported as a Chrome trace, placed at its simulated time.
+ *
+ * The simulation is single-threaded, so the profiler is not synchronized.
+ */
+class CallbackProfiler : noncopyable
+{
+public:
+  enum CallbackType {
+    ON_DATA,
+    ON_TIMEOUT,
+    ON_INTEREST
+  };
+
+  struct Call
+  {
+    Name name;
+    uint32_t context; ///< simulator context, i.e. node id
+    time::steady_clock::TimePoint simulatedTime;
+    time::nanoseconds wallDuration;
+  };
+
+  struct Entry
+  {
+    uint64_t nCalls = 0;
+    time::nanoseconds totalWallDuration = time::nanoseconds::zero();
+    time::nanoseconds maxWallDuration = time::nanoseconds::zero();
+    std::vector<Call> slowestCalls; ///< slowest first
+  };
+
+  typedef std::map<std::pair<CallbackType, Name>, Entry> Profile;
+
+  /**
+   * @brief Measures one callback invocation from construction to destruction
+   */
+  class Scope : noncopyable
+  {
+  public:
+    /**
+     * @param name Interest name; must outlive the Scope
+     */
+    Scope(CallbackType type, const Name& name);
+
+    /**
+     * @param name Interest name; must outlive the Scope
+     * @param prefix prefix under which the call is recorded; must outlive the Scope
+     */
+    Scope(CallbackType type, const Name& name, const Name& prefix);
+
+    ~Scope();
+
+  private:
+    CallbackType m_type;
+    const Name& m_name;
+    const Name* m_prefix;
+    time::steady_clock::TimePoint m_simulatedTime;
+    boost::chrono::steady_clock::time_point m_start;
+  };
+
+public:
+  static CallbackProfiler&
+  getInstance();
+
+  CallbackProfiler();
+
+  /**
+   * @brief Record a call
+   * @param prefix if empty, the first getPrefixLength() components of @p name are used
+   */
+  void
+  record(CallbackType type, const Name& name, const Name& prefix,
+         const time::steady_clock::TimePoint& simulatedTime,
+         const time::nanoseconds& wallDuration);
+
+  void
+  reset();
+
+  size_t
+  getPrefixLength() const
+  {
+    return m_prefixLength;
+  }
+
+  void
+  setPrefixLength(size_t prefixLength)
+  {
+    m_prefixLength = prefixLength;
+  }
+
+  /**
+   * @brief Number of slowest calls kept for each prefix
+   */
+  void
+  setNSlowestCalls(size_t nSlowestCalls)
+  {
+    m_nSlowestCalls = nSlowestCalls;
+  }
+
+  /**
+   * @brief Record every call for writeChromeTrace, up to @p maxCalls calls
+   */
+  void
+  enableTrace(size_t maxCalls = 1000000);
+
+  void
+  disableTrace();
+
+  const Profile&
+  getProfile() const
+  {
+    return m_profile;
+  }
+
+  /**
+   * @brief Print one line per callback type and prefix, by decreasing total time,
+   *        followed by the slowest calls
+   */
+  void
+  printFlatProfile(std::ostream& os) const;
+
+  /**
+   * @brief Write the traced calls in the Chrome trace event JSON format
+   *
+   * Each call is a complete event whose timestamp is the simulated time of the call and
+   * whose duration is its wall-clock duration, on a thread per simulator context.
+   * The output can be loaded in chrome://tracing.
+   */
+  void
+  writeChromeTrace(std::ostream& os) const;
+
+private:
+  Profile m_profile;
+  size_t m_prefixLength;
+  size_t m_nSlowestCalls;
+
+  bool m_isTraceEnabled;
+  size_t m_maxTracedCalls;
+  std::vector<std::pair<CallbackType, Call>> m_trace;
+};
+
+std::ostream&
+operator<<(std::ostream& os, CallbackProfiler::CallbackType type);
+
+} // namespace util
+} // namespace ndn
+
+#ifdef NDN_CXX_WITH_CALLBACK_PROFILING
+#define NDN_PROFILE_CALLBACK(type, ...) \
+  ::ndn::util::CallbackProfiler::Scope ndnCallbackProfilerScope(type, __VA_ARGS__)
+#else
+#define NDN_PROFILE_CALLBACK(type, ...)
+#endif // NDN_CXX_WITH_CALLBACK_PROFILING
+
+#endif // NDN_UTIL_CALLBACK_PROFILER_HPP
@@ -23,12 +23,74 @@
 #include "../transport/transport.hpp"
 #include "../management/nfd-controller.hpp"
 #include "../management/nfd-control-response.hpp"
+#include "../encoding/buffer-stream.hpp"
+
+#include <algorithm>
+#include <ostream>
 
 namespace ndn {
 namespace util {
 
 const DummyClientFace::Options DummyClientFace::DEFAULT_OPTIONS { true, false };
 
+const time::nanoseconds DummyClientFace::REPLAY_TICK = time::milliseconds(1);
+
+const size_t DummyClientFace::REPLAY_BATCH_SIZE = 1024;
+
+/** \brief check that \p block can be injected by a replay
+ *  \throw tlv::Error \p block is neither an Interest nor a Data, or is an Interest that
+ *                    cannot be decoded
+ */
+static void
+checkReplayPacket(const Block& block, size_t index)
+{
+  if (block.type() == tlv::Interest) {
+    try {
+      Interest interest(block);
+    }
+    catch (const tlv::Error& e) {
+      BOOST_THROW_EXCEPTION(tlv::Error("Invalid Interest at packet " + std::to_string(index) +
+                                       ": " + e.what()));
+    }
+  }
+  else if (block.type() != tlv::Data) {
+    BOOST_THROW_EXCEPTION(tlv::Error("Block of type " + std::to_string(block.type()) +
+                                     " at packet " + std::to_string(index) +
+                                     " is neither an Interest nor a Data"));
+  }
+}
+
+DummyClientFace::ReplayStatistics::ReplayStatistics()
+  : nInjectedInterests(0)
+  , nInjectedData(0)
+  , nSentInterests(0)
+  , nSentData(0)
+  , duration(time::nanoseconds::zero())
+{
+}
+
+double
+DummyClientFace::ReplayStatistics::getThroughput() const
+{
+  if (duration <= time::nanoseconds::zero()) {
+    return 0.0;
+  }
+  return (nInjectedInterests + nInjectedData) * 1000000000.0 / duration.count();
+}
+
+std::ostream&
+operator<<(std::ostream& os, const DummyClientFace::ReplayStatistics& statistics)
+{
+  os << "Injected: interests=" << statistics.nInjectedInterests
+     << " data=" << statistics.nInjectedData
+     << " duration=" << statistics.duration.count() << "ns"
+     << " throughput=" << statistics.getThroughput() << "/s\n";
+  os << "Sent: interests=" << statistics.nSentInterests
+     << " data=" << statistics.nSentData << "\n";
+  os << "Response latency: " << statistics.responseLatency << "\n";
+  return os;
+}
+
 class DummyClientFace::Transport : public ndn::Transport
 {
 public:
@@ -81,16 +143,26 @@ public:
 };
 
 DummyClientFace::DummyClientFace(const Options& options, shared_ptr<Transport> transport)
-  : Face(transport)
+  : Face()
   , m_transport(transport)
+  , m_scheduler()
+  , m_replayPosition(0)
+  , m_replayRate(0.0)
+  , m_isReplayStarted(false)
+  , m_replayEvent(m_scheduler)
 {
   this->construct(options);
 }
 
 DummyClientFace::DummyClientFace(const Options& options, shared_ptr<Transport> transport,
                                  boost::asio::io_service& ioService)
-  : Face(transport, ioService)
+  : Face(ioService)
   , m_transport(transport)
+  , m_scheduler()
+  , m_replayPosition(0)
+  , m_replayRate(0.0)
+  , m_isReplayStarted(false)
+  , m_replayEvent(m_scheduler)
 {
   this->construct(options);
 }
@@ -117,6 +189,9 @@ DummyClientFace::construct(const Options& options)
     }
   });
 
+  onSendInterest.connect(bind(&DummyClientFace::recordSentInterest, this, _1));
+  onSendData.connect(bind(&DummyClientFace::recordSentData, this, _1));
+
   if (options.enablePacketLogging)
     this->enablePacketLogging();
 
@@ -160,7 +235,7 @@ DummyClientFace::enableRegistrationReply()
     KeyChain keyChain;
     keyChain.sign(*data, security::SigningInfo(security::SigningInfo::SIGNER_TYPE_SHA256));
 
-    this->getIoService().post([this, data] { this->receive(*data); });
+    m_scheduler.scheduleEvent(time::nanoseconds::zero(), [this, data] { this->receive(*data); });
   });
 }
 
@@ -192,6 +267,170 @@ DummyClientFace::receive<Interest>(const Interest& packet);
 template void
 DummyClientFace::receive<Data>(const Data& packet);
 
+std::vector<Block>
+DummyClientFace::loadTrace(std::istream& is)
+{
+  OBufferStream os;
+  os << is.rdbuf();
+  ConstBufferPtr buffer = os.buf();
+
+  std::vector<Block> trace;
+  size_t offset = 0;
+  while (offset < buffer->size()) {
+    bool isOk = false;
+    Block block;
+    std::tie(isOk, block) = Block::fromBuffer(buffer, offset);
+    if (!isOk) {
+      BOOST_THROW_EXCEPTION(tlv::Error("Incomplete block at offset " + std::to_string(offset)));
+    }
+    checkReplayPacket(block, trace.size());
+    offset += block.size();
+    trace.push_back(block);
+  }
+  return trace;
+}
+
+void
+DummyClientFace::startReplay(std::vector<Block> trace, double rate, size_t captureCapacity)
+{
+  BOOST_ASSERT(rate >= 0.0);
+
+  // checked here, so that the scheduler events injecting the packets never throw
+  for (size_t i = 0; i < trace.size(); ++i) {
+    checkReplayPacket(trace[i], i);
+  }
+
+  m_replayTrace = std::move(trace);
+  m_replayPosition = 0;
+  m_replayRate = rate;
+  m_isReplayStarted = true;
+  m_replayStart = time::steady_clock::now();
+  m_replayStatistics = ReplayStatistics();
+  m_replayPendingInterests.clear();
+  m_replayInterestExpiries.clear();
+
+  replayCapturedInterests.clear();
+  replayCapturedInterests.set_capacity(captureCapacity);
+  replayCapturedDatas.clear();
+  replayCapturedDatas.set_capacity(captureCapacity);
+
+  m_replayEvent = m_scheduler.scheduleEvent(time::nanoseconds::zero(),
+                                            bind(&DummyClientFace::injectReplayBatch, this));
+}
+
+void
+DummyClientFace::stopReplay()
+{
+  m_replayEvent.cancel();
+  m_replayTrace.clear();
+  m_replayPosition = 0;
+}
+
+void
+DummyClientFace::injectReplayBatch()
+{
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+
+  size_t end = m_replayTrace.size();
+  if (m_replayRate > 0.0) {
+    // every packet due by now, the first one being due at the start
+    double elapsed = time::duration_cast<time::nanoseconds>(now - m_replayStart).count() / 1e9;
+    end = std::min(end, static_cast<size_t>(elapsed * m_replayRate) + 1);
+  }
+  else {
+    end = std::min(end, m_replayPosition + REPLAY_BATCH_SIZE);
+  }
+
+  this->expireReplayPendingInterests(now);
+
+  for (; m_replayPosition < end; ++m_replayPosition) {
+    const Block& wire = m_replayTrace[m_replayPosition];
+    if (wire.type() == tlv::Interest) {
+      ++m_replayStatistics.nInjectedInterests;
+      Interest interest(wire);
+      time::steady_clock::TimePoint expiry = now + interest.getInterestLifetime();
+      ReplayPendingInterest pending{now, expiry};
+      if (m_replayPendingInterests.insert(std::make_pair(interest.getName(), pending)).second) {
+        m_replayInterestExpiries.insert(std::make_pair(expiry, interest.getName()));
+      }
+    }
+    else {
+      ++m_replayStatistics.nInjectedData;
+    }
+    m_replayStatistics.duration = now - m_replayStart;
+    m_transport->receive(wire);
+  }
+
+  if (m_replayPosition < m_replayTrace.size()) {
+    time::nanoseconds delay = time::nanoseconds::zero();
+    if (m_replayRate > 0.0) {
+      time::nanoseconds nextDue(static_cast<time::nanoseconds::rep>(m_replayPosition * 1e9 /
+                                                                     m_replayRate));
+      delay = std::max<time::nanoseconds>(nextDue - (now - m_replayStart), REPLAY_TICK);
+    }
+    m_replayEvent = m_scheduler.scheduleEvent(delay,
+                                              bind(&DummyClientFace::injectReplayBatch, this));
+    return;
+  }
+
+  m_replayTrace.clear();
+  m_replayPosition = 0;
+  onReplayEnd(m_replayStatistics);
+}
+
+void
+DummyClientFace::recordSentInterest(const Interest& interest)
+{
+  if (!m_isReplayStarted) {
+    return;
+  }
+
+  ++m_replayStatistics.nSentInterests;
+  if (replayCapturedInterests.capacity() > 0) {
+    replayCapturedInterests.push_back(interest);
+  }
+}
+
+void
+DummyClientFace::recordSentData(const Data& data)
+{
+  if (!m_isReplayStarted) {
+    return;
+  }
+
+  ++m_replayStatistics.nSentData;
+  if (replayCapturedDatas.capacity() > 0) {
+    replayCapturedDatas.push_back(data);
+  }
+
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  this->expireReplayPendingInterests(now);
+
+  // the longest prefix is the most specific Interest this Data answers
+  const Name& name = data.getName();
+  for (ssize_t length = name.size(); length >= 0; --length) {
+    auto pending = m_replayPendingInterests.find(name.getPrefix(length));
+    if (pending != m_replayPendingInterests.end()) {
+      m_replayStatistics.responseLatency.add(now - pending->second.injectTime);
+      m_replayPendingInterests.erase(pending);
+      break;
+    }
+  }
+}
+
+void
+DummyClientFace::expireReplayPendingInterests(const time::steady_clock::TimePoint& now)
+{
+  while (!m_replayInterestExpiries.empty() && m_replayInterestExpiries.begin()->first <= now) {
+    auto expiry = m_replayInterestExpiries.begin();
+    // the Interest may have been answered, and its name injected again since
+    auto pending = m_replayPendingInterests.find(expiry->second);
+    if (pending != m_replayPendingInterests.end() && pending->second.expiry == expiry->first) {
+      m_replayPendingInterests.erase(pending);
+    }
+    m_replayInterestExpiries.erase(expiry);
+  }
+}
 
 shared_ptr<DummyClientFace>
 makeDummyClientFace(const DummyClientFace::Options& options)
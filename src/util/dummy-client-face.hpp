@@ -24,6 +24,11 @@
 
 #include "../face.hpp"
 #include "signal.hpp"
+#include "scheduler.hpp"
+#include "scheduler-scoped-event-id.hpp"
+
+#include <boost/circular_buffer.hpp>
+#include <map>
 
 namespace ndn {
 namespace util {
@@ -47,6 +52,29 @@ public:
     bool enableRegistrationReply;
   };
 
+  /** \brief statistics of a replay
+   */
+  struct ReplayStatistics
+  {
+    ReplayStatistics();
+
+    /** \return injected packets per second, or zero if the replay has not lasted yet
+     */
+    double
+    getThroughput() const;
+
+    uint64_t nInjectedInterests;
+    uint64_t nInjectedData;
+    /// Interests sent by the face since the replay started
+    uint64_t nSentInterests;
+    /// Data sent by the face since the replay started
+    uint64_t nSentData;
+    /// time from the start of the replay to the last injected packet
+    time::nanoseconds duration;
+    /// time from an injected Interest to the first sent Data under its name
+    LatencyHistogram responseLatency;
+  };
+
   /** \brief cause the Face to receive a packet
    *  \tparam Packet either Interest or Data
    */
@@ -54,6 +82,52 @@ public:
   void
   receive(const Packet& packet);
 
+  /** \brief read a packet trace: Interest and Data TLV blocks, one after another
+   *
+   *  The blocks share a single buffer holding the whole trace.
+   *
+   *  \throw tlv::Error the trace ends with an incomplete block, or holds a block that is
+   *                    neither an Interest nor a Data, or an Interest that cannot be decoded
+   */
+  static std::vector<Block>
+  loadTrace(std::istream& is);
+
+  /** \brief cause the Face to receive the packets of \p trace, in order, at \p rate
+   *
+   *  Packets are injected from scheduler events, so the application keeps running between
+   *  them.  Pacing has a granularity of REPLAY_TICK: when packets are due more often, each
+   *  event injects all packets due by then.  Replay statistics, replayCapturedInterests,
+   *  and replayCapturedDatas are reset.  A replay in progress is stopped.
+   *
+   *  \param rate packets per second; zero injects REPLAY_BATCH_SIZE packets per zero-delay
+   *              event, as fast as the application processes them
+   *  \param captureCapacity how many of the most recently sent Interests and Data are kept
+   *                         in replayCapturedInterests and replayCapturedDatas
+   *  \throw tlv::Error \p trace holds a block that loadTrace would reject; no replay is
+   *                    started then
+   */
+  void
+  startReplay(std::vector<Block> trace, double rate, size_t captureCapacity = 0);
+
+  /** \brief stop injecting packets; statistics and captured packets are kept
+   */
+  void
+  stopReplay();
+
+  bool
+  isReplaying() const
+  {
+    return m_replayPosition < m_replayTrace.size();
+  }
+
+  /** \return the statistics of the current or last replay
+   */
+  const ReplayStatistics&
+  getReplayStatistics() const
+  {
+    return m_replayStatistics;
+  }
+
 private: // constructors
   class Transport;
 
@@ -80,7 +154,29 @@ private:
   void
   enableRegistrationReply();
 
+  void
+  recordSentInterest(const Interest& interest);
+
+  void
+  recordSentData(const Data& data);
+
+  void
+  injectReplayBatch();
+
+  /** \brief forget the injected Interests whose lifetime has passed by \p now
+   */
+  void
+  expireReplayPendingInterests(const time::steady_clock::TimePoint& now);
+
 public:
+  /** \brief interval between scheduler events of a paced replay
+   */
+  static const time::nanoseconds REPLAY_TICK;
+
+  /** \brief packets injected by each event of an unpaced replay
+   */
+  static const size_t REPLAY_BATCH_SIZE;
+
   /** \brief default options
    *
    *  enablePacketLogging=true
@@ -116,10 +212,45 @@ public:
    */
   Signal<DummyClientFace, Data> onSendData;
 
+  /** \brief most recently sent Interests, kept since startReplay
+   */
+  boost::circular_buffer<Interest> replayCapturedInterests;
+
+  /** \brief most recently sent Data, kept since startReplay
+   */
+  boost::circular_buffer<Data> replayCapturedDatas;
+
+  /** \brief emits after the last packet of a replay has been injected
+   *
+   *  The application may still respond to that packet, updating the statistics afterwards.
+   */
+  Signal<DummyClientFace, ReplayStatistics> onReplayEnd;
+
 private:
   shared_ptr<Transport> m_transport;
+
+  Scheduler m_scheduler;
+  std::vector<Block> m_replayTrace;
+  size_t m_replayPosition;
+  double m_replayRate;
+  bool m_isReplayStarted;
+  time::steady_clock::TimePoint m_replayStart;
+  ReplayStatistics m_replayStatistics;
+  struct ReplayPendingInterest
+  {
+    time::steady_clock::TimePoint injectTime;
+    time::steady_clock::TimePoint expiry;
+  };
+  /// injected Interests neither answered nor expired yet, by name
+  std::map<Name, ReplayPendingInterest> m_replayPendingInterests;
+  /// names in m_replayPendingInterests by expiry, possibly with stale entries
+  std::multimap<time::steady_clock::TimePoint, Name> m_replayInterestExpiries;
+  scheduler::ScopedEventId m_replayEvent;
 };
 
+std::ostream&
+operator<<(std::ostream& os, const DummyClientFace::ReplayStatistics& statistics);
+
 shared_ptr<DummyClientFace>
 makeDummyClientFace(const DummyClientFace::Options& options = DummyClientFace::DEFAULT_OPTIONS);
 
@@ -23,127 +23,166 @@
 
 #include "scheduler.hpp"
 
-namespace ns3 {
-
-/// @cond include_hidden
-
-template<>
-struct EventMemberImplObjTraits<std::function<void()>> {
-  typedef std::function<void()> T;
-  static T&
-  GetReference(T& p)
-  {
-    return p;
-  }
-};
-
-/// @endcond
-
-} // namespace ns3
-
 namespace ndn {
 namespace util {
 namespace scheduler {
 
-struct EventIdImpl
+/** \brief released event records, reused by subsequent events on the same thread
+ *
+ *  Each thread has its own list, so that Schedulers (and EventIds) on different threads
+ *  do not race.  A record released on another thread than the one it was allocated on
+ *  simply moves to the free list of the releasing thread.
+ */
+struct EventRecord::FreeList
 {
-  EventIdImpl(const Scheduler::EventQueue::iterator& event)
-    : m_event(event)
-    , m_isValid(true)
+  ~FreeList()
   {
+    isDestroyed = true;
+    while (head != nullptr) {
+      EventRecord* record = head;
+      head = record->m_next;
+      delete record;
+    }
   }
 
-  void
-  invalidate()
-  {
-    m_isValid = false;
-  }
+  EventRecord* head = nullptr;
 
-  bool
-  isValid() const
-  {
-    return m_isValid;
-  }
+  /** \brief set when the list of this thread has been destroyed at thread exit;
+   *         records released after that point are deleted
+   */
+  static thread_local bool isDestroyed;
 
-  operator const Scheduler::EventQueue::iterator&() const
-  {
-    return m_event;
-  }
+  static thread_local FreeList records;
+};
 
-  void
-  reset(const Scheduler::EventQueue::iterator& newIterator)
-  {
-    m_event = newIterator;
-    m_isValid = true;
+thread_local bool EventRecord::FreeList::isDestroyed = false;
+thread_local EventRecord::FreeList EventRecord::FreeList::records;
+
+EventRecord*
+EventRecord::allocate()
+{
+  EventRecord* record = FreeList::isDestroyed ? nullptr : FreeList::records.head;
+  if (record != nullptr) {
+    FreeList::records.head = record->m_next;
+    record->m_next = nullptr;
+  }
+  else {
+    record = new EventRecord;
   }
 
-private:
-  Scheduler::EventQueue::iterator m_event;
-  bool m_isValid;
-};
+  record->m_refCount = 1;
+  return record;
+}
 
-Scheduler::EventInfo::EventInfo(const time::nanoseconds& after,
-                                const Event& event)
-  : m_scheduledTime(time::steady_clock::now() + after)
-  , m_event(event)
+void
+EventRecord::recycle(EventRecord* record) noexcept
 {
+  BOOST_ASSERT(record->m_scheduler == nullptr);
+  record->m_callback.reset();
+
+  if (FreeList::isDestroyed) {
+    delete record;
+    return;
+  }
+  record->m_next = FreeList::records.head;
+  FreeList::records.head = record;
 }
 
-Scheduler::EventInfo::EventInfo(const time::steady_clock::TimePoint& when,
-                                const EventInfo& previousEvent)
-  : m_scheduledTime(when)
-  , m_event(previousEvent.m_event)
-  , m_eventId(previousEvent.m_eventId)
+Scheduler::Scheduler()
+  : m_pendingEvents(nullptr)
 {
 }
 
-time::nanoseconds
-Scheduler::EventInfo::expiresFromNow() const
+Scheduler::Scheduler(boost::asio::io_service& ioService)
+  : m_pendingEvents(nullptr)
 {
-  time::steady_clock::TimePoint now = time::steady_clock::now();
-  if (now > m_scheduledTime)
-    return time::seconds(0); // event should be scheduled ASAP
-  else
-    return m_scheduledTime - now;
 }
 
-
-Scheduler::Scheduler(boost::asio::io_service& ioService)
-  : m_scheduledEvent(m_events.end())
+Scheduler::~Scheduler()
 {
+  cancelAllEvents();
 }
 
 EventId
-Scheduler::scheduleEvent(const time::nanoseconds& after,
-                         const Event& event)
+Scheduler::schedule(const time::nanoseconds& after, EventRecord* record)
 {
-  ns3::EventId id = ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()),
-                                             &std::function<void()>::operator(), event);
-  auto id_ptr = std::make_shared<ns3::EventId>(id);
-  m_events.insert(id_ptr);
-  return id_ptr;
+  // the reference returned by EventRecord::allocate is the one held while the event is pending
+  record->m_scheduler = this;
+  record->m_prev = nullptr;
+  record->m_next = m_pendingEvents;
+  if (m_pendingEvents != nullptr) {
+    m_pendingEvents->m_prev = record;
+  }
+  m_pendingEvents = record;
+
+  record->m_simulatorEvent = ns3::Simulator::Schedule(ns3::NanoSeconds(after.count()),
+                                                      &Scheduler::onEvent, record);
+  record->ref();
+  return EventId(record);
 }
 
 void
 Scheduler::cancelEvent(const EventId& eventId)
 {
-  if (eventId != nullptr) {
-    ns3::Simulator::Remove(*eventId);
-    const_cast<EventId&>(eventId).reset();
-    m_events.erase(eventId);
+  if (eventId.m_record != nullptr && eventId.m_record->m_scheduler != nullptr) {
+    eventId.m_record->m_scheduler->cancel(eventId.m_record);
   }
+  const_cast<EventId&>(eventId).reset();
 }
 
 void
 Scheduler::cancelAllEvents()
 {
-  for (auto i = m_events.begin(); i != m_events.end(); i++) {
-    if ((*i) != nullptr) {
-      ns3::Simulator::Remove((**i));
-      const_cast<EventId&>(*i).reset();
-    }
+  while (m_pendingEvents != nullptr) {
+    cancel(m_pendingEvents);
+  }
+}
+
+void
+Scheduler::cancel(EventRecord* record)
+{
+  BOOST_ASSERT(record->m_scheduler == this);
+
+  // Remove takes the event out of the simulator queue right away, at O(log n) with the
+  // default map scheduler.  Simulator::Cancel would be O(1), but cancelled events would stay
+  // queued until their time comes, which adds up with long timeouts that are usually
+  // cancelled, such as Interest lifetimes.
+  ns3::Simulator::Remove(record->m_simulatorEvent);
+  record->m_simulatorEvent = ns3::EventId();
+  unlink(record);
+
+  // the callback may capture objects whose destructors cancel other events
+  record->m_callback.reset();
+  record->unref();
+}
+
+void
+Scheduler::unlink(EventRecord* record) noexcept
+{
+  if (record->m_prev != nullptr) {
+    record->m_prev->m_next = record->m_next;
   }
-  m_events.clear();
+  else {
+    m_pendingEvents = record->m_next;
+  }
+  if (record->m_next != nullptr) {
+    record->m_next->m_prev = record->m_prev;
+  }
+  record->m_prev = record->m_next = nullptr;
+  record->m_scheduler = nullptr;
+}
+
+void
+Scheduler::onEvent(EventRecord* record)
+{
+  BOOST_ASSERT(record->m_scheduler != nullptr);
+  record->m_simulatorEvent = ns3::EventId();
+  record->m_scheduler->unlink(record);
+
+  // keeps the record alive even if the callback drops all EventIds and destroys the Scheduler
+  EventId self(record);
+  record->m_callback();
+  record->m_callback.reset();
 }
 
 } // namespace scheduler
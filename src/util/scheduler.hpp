@@ -27,35 +27,299 @@
 
 #include "ns3/simulator.h"
 
-#include <set>
-
 namespace ndn {
 namespace util {
 namespace scheduler {
 
-struct EventIdImpl; ///< \brief Private storage of information about the event
+class Scheduler;
+
+/** \brief Type-erased void() callable that stores small function objects inline
+ *
+ *  Function objects of up to INLINE_SIZE bytes, which covers lambdas capturing a few
+ *  pointers or shared_ptrs and bound member functions, do not allocate.
+ */
+class EventCallback : noncopyable
+{
+public:
+  EventCallback() noexcept
+    : m_invoke(nullptr)
+    , m_destroy(nullptr)
+  {
+  }
+
+  ~EventCallback()
+  {
+    reset();
+  }
+
+  template<typename F>
+  void
+  assign(F&& f)
+  {
+    typedef typename std::decay<F>::type Function;
+
+    reset();
+    assign<Function>(std::forward<F>(f),
+                     std::integral_constant<bool, sizeof(Function) <= INLINE_SIZE &&
+                                                  alignof(Function) <= alignof(Storage)>());
+  }
+
+  void
+  operator()()
+  {
+    BOOST_ASSERT(m_invoke != nullptr);
+    m_invoke(&m_storage);
+  }
+
+  /** \brief destroys the stored function object
+   */
+  void
+  reset() noexcept
+  {
+    if (m_destroy != nullptr) {
+      // the destructor of the function object may re-enter
+      void (*destroy)(void*) = m_destroy;
+      m_invoke = nullptr;
+      m_destroy = nullptr;
+      destroy(&m_storage);
+    }
+  }
+
+  explicit
+  operator bool() const noexcept
+  {
+    return m_invoke != nullptr;
+  }
+
+private:
+  template<typename Function, typename F>
+  void
+  assign(F&& f, std::true_type)
+  {
+    new (&m_storage) Function(std::forward<F>(f));
+    m_invoke = [] (void* storage) { (*static_cast<Function*>(storage))(); };
+    m_destroy = [] (void* storage) { static_cast<Function*>(storage)->~Function(); };
+  }
+
+  template<typename Function, typename F>
+  void
+  assign(F&& f, std::false_type)
+  {
+    *static_cast<Function**>(static_cast<void*>(&m_storage)) = new Function(std::forward<F>(f));
+    m_invoke = [] (void* storage) { (**static_cast<Function**>(storage))(); };
+    m_destroy = [] (void* storage) { delete *static_cast<Function**>(storage); };
+  }
+
+public:
+  static const size_t INLINE_SIZE = 48;
+
+private:
+  typedef std::aligned_storage<INLINE_SIZE>::type Storage;
+
+  Storage m_storage;
+  void (*m_invoke)(void*);
+  void (*m_destroy)(void*);
+};
+
+/** \brief Private storage of information about the event
+ *
+ *  Records are reference-counted by EventId handles and by the Scheduler while the event
+ *  is pending, and are recycled through a per-thread free list when released.
+ */
+class EventRecord : noncopyable
+{
+public:
+  static EventRecord*
+  allocate();
+
+  void
+  ref() noexcept
+  {
+    ++m_refCount;
+  }
+
+  void
+  unref() noexcept
+  {
+    BOOST_ASSERT(m_refCount > 0);
+    if (--m_refCount == 0) {
+      recycle(this);
+    }
+  }
+
+private:
+  EventRecord() noexcept
+    : m_prev(nullptr)
+    , m_next(nullptr)
+    , m_scheduler(nullptr)
+    , m_refCount(0)
+  {
+  }
+
+  static void
+  recycle(EventRecord* record) noexcept;
+
+  struct FreeList;
+
+private:
+  EventRecord* m_prev; ///< in the pending list of m_scheduler
+  EventRecord* m_next; ///< in the pending list of m_scheduler, or in the free list
+  Scheduler* m_scheduler; ///< nullptr unless the event is pending
+  ns3::EventId m_simulatorEvent;
+  EventCallback m_callback;
+  uint32_t m_refCount;
+
+  friend class Scheduler;
+  friend class EventId;
+};
 
 /** \class EventId
- *  \brief Opaque type (shared_ptr) representing ID of a scheduled event
+ *  \brief Opaque handle representing ID of a scheduled event
+ *
+ *  Default-constructed EventId and EventId that have been passed to Scheduler::cancelEvent
+ *  compare equal to nullptr.
+ *
+ *  For compatibility with code written against the former shared_ptr<ns3::EventId>,
+ *  a non-null EventId dereferences to the ns3::EventId of the event, so that, e.g.,
+ *  eventId->IsRunning() still works; that ns3::EventId is expired once the event has fired
+ *  or has been cancelled.  EventId can also be ordered and hashed.
  */
-typedef std::shared_ptr<ns3::EventId> EventId;
+class EventId
+{
+public:
+  EventId() noexcept
+    : m_record(nullptr)
+  {
+  }
+
+  EventId(std::nullptr_t) noexcept
+    : m_record(nullptr)
+  {
+  }
+
+  EventId(const EventId& other) noexcept
+    : m_record(other.m_record)
+  {
+    if (m_record != nullptr) {
+      m_record->ref();
+    }
+  }
+
+  EventId(EventId&& other) noexcept
+    : m_record(other.m_record)
+  {
+    other.m_record = nullptr;
+  }
+
+  ~EventId()
+  {
+    reset();
+  }
+
+  EventId&
+  operator=(EventId other) noexcept
+  {
+    std::swap(m_record, other.m_record);
+    return *this;
+  }
+
+  void
+  reset() noexcept
+  {
+    if (m_record != nullptr) {
+      EventRecord* record = m_record;
+      m_record = nullptr;
+      record->unref();
+    }
+  }
+
+  explicit
+  operator bool() const noexcept
+  {
+    return m_record != nullptr;
+  }
+
+  const ns3::EventId&
+  operator*() const noexcept
+  {
+    BOOST_ASSERT(m_record != nullptr);
+    return m_record->m_simulatorEvent;
+  }
+
+  const ns3::EventId*
+  operator->() const noexcept
+  {
+    return &**this;
+  }
+
+  friend bool
+  operator==(const EventId& lhs, const EventId& rhs) noexcept
+  {
+    return lhs.m_record == rhs.m_record;
+  }
+
+  friend bool
+  operator!=(const EventId& lhs, const EventId& rhs) noexcept
+  {
+    return lhs.m_record != rhs.m_record;
+  }
+
+  friend bool
+  operator<(const EventId& lhs, const EventId& rhs) noexcept
+  {
+    return std::less<const EventRecord*>()(lhs.m_record, rhs.m_record);
+  }
+
+private:
+  /** \brief takes over one reference to \p record
+   */
+  explicit
+  EventId(EventRecord* record) noexcept
+    : m_record(record)
+  {
+  }
+
+private:
+  EventRecord* m_record;
+
+  friend class Scheduler;
+  friend struct std::hash<EventId>;
+};
 
 /**
  * \brief Generic scheduler
  */
-class Scheduler
+class Scheduler : noncopyable
 {
 public:
   typedef function<void()> Event;
 
+  /** \brief create a scheduler whose events run on the ns-3 simulator
+   */
+  Scheduler();
+
+  /** \brief create a scheduler whose events run on the ns-3 simulator
+   *  \param ioService unused (kept for compatibility); it is never dereferenced
+   */
   Scheduler(boost::asio::io_service& ioService);
 
+  /** \brief cancels all scheduled events
+   */
+  ~Scheduler();
+
   /**
    * \brief Schedule one time event after the specified delay
+   * \param event any void() function object; small ones are stored without allocation
    * \returns EventId that can be used to cancel the scheduled event
    */
+  template<typename E>
   EventId
-  scheduleEvent(const time::nanoseconds& after, const Event& event);
+  scheduleEvent(const time::nanoseconds& after, E&& event)
+  {
+    EventRecord* record = EventRecord::allocate();
+    record->m_callback.assign(std::forward<E>(event));
+    return schedule(after, record);
+  }
 
   /**
    * \brief Cancel scheduled event
@@ -70,37 +334,20 @@ public:
   cancelAllEvents();
 
 private:
-  struct EventInfo
-  {
-    EventInfo(const time::nanoseconds& after, const Event& event);
-
-    EventInfo(const time::steady_clock::TimePoint& when, const EventInfo& previousEvent);
-
-    bool
-    operator <=(const EventInfo& other) const
-    {
-      return this->m_scheduledTime <= other.m_scheduledTime;
-    }
-
-    bool
-    operator <(const EventInfo& other) const
-    {
-      return this->m_scheduledTime < other.m_scheduledTime;
-    }
+  EventId
+  schedule(const time::nanoseconds& after, EventRecord* record);
 
-    time::nanoseconds
-    expiresFromNow() const;
+  void
+  cancel(EventRecord* record);
 
-    time::steady_clock::TimePoint m_scheduledTime;
-    Event m_event;
-    mutable EventId m_eventId;
-  };
+  void
+  unlink(EventRecord* record) noexcept;
 
-  typedef std::multiset<EventId> EventQueue;
-  friend struct EventIdImpl;
+  static void
+  onEvent(EventRecord* record);
 
-  EventQueue m_events;
-  EventQueue::iterator m_scheduledEvent;
+private:
+  EventRecord* m_pendingEvents; ///< head of the list of pending events
 };
 
 } // namespace scheduler
@@ -115,4 +362,18 @@ using util::scheduler::EventId;
 
 } // namespace ndn
 
+namespace std {
+
+template<>
+struct hash<ndn::util::scheduler::EventId>
+{
+  size_t
+  operator()(const ndn::util::scheduler::EventId& eventId) const noexcept
+  {
+    return hash<const ndn::util::scheduler::EventRecord*>()(eventId.m_record);
+  }
+};
+
+} // namespace std
+
 #endif // NDN_UTIL_SCHEDULER_HPP
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Data Footprint Benchmark
+
+#include "data.hpp"
+#include "encoding/block-helpers.hpp"
+#include "security/digest-sha256.hpp"
+
+#include "boost-test.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+// Every heap allocation made by the program is counted, so that the report below
+// shows how many allocations and bytes a single Data packet costs.
+static size_t g_nAllocations = 0;
+static size_t g_nAllocatedBytes = 0;
+
+void*
+operator new(size_t size)
+{
+  ++g_nAllocations;
+  g_nAllocatedBytes += size;
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void
+operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+namespace ndn {
+namespace tests {
+
+class DataFootprintFixture
+{
+public:
+  static Block
+  makeDataWire(size_t nAppMetaInfo)
+  {
+    Data data("/benchmark/data/footprint");
+    data.setFreshnessPeriod(time::seconds(10));
+    for (size_t i = 0; i < nAppMetaInfo; ++i) {
+      MetaInfo metaInfo = data.getMetaInfo();
+      metaInfo.addAppMetaInfo(makeNonNegativeIntegerBlock(128 + i, i));
+      data.setMetaInfo(metaInfo);
+    }
+    data.setContent(reinterpret_cast<const uint8_t*>("payload"), 7);
+    DigestSha256 signature;
+    signature.setKeyLocator(KeyLocator("/benchmark/key/locator"));
+    data.setSignature(signature);
+    data.setSignatureValue(makeBinaryBlock(tlv::SignatureValue,
+                                           reinterpret_cast<const uint8_t*>("sigvalue"), 8));
+    const Block& wire = data.wireEncode();
+    // copy of the wire without parsed sub-elements, as if just received
+    return Block(wire.getBuffer(), wire.begin(), wire.end(), false);
+  }
+
+  template<typename F>
+  static void
+  report(const std::string& name, const F& f)
+  {
+    size_t nAllocations = g_nAllocations;
+    size_t nAllocatedBytes = g_nAllocatedBytes;
+    f();
+    std::cout << name << ": " << (g_nAllocations - nAllocations) << " allocations, "
+              << (g_nAllocatedBytes - nAllocatedBytes) << " bytes" << std::endl;
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(DataFootprintBenchmark, DataFootprintFixture)
+
+BOOST_AUTO_TEST_CASE(ObjectSize)
+{
+  std::cout << "sizeof(Block): " << sizeof(Block) << std::endl
+            << "sizeof(MetaInfo): " << sizeof(MetaInfo) << std::endl
+            << "sizeof(SignatureInfo): " << sizeof(SignatureInfo) << std::endl
+            << "sizeof(Signature): " << sizeof(Signature) << std::endl
+            << "sizeof(Data): " << sizeof(Data) << std::endl;
+}
+
+BOOST_AUTO_TEST_CASE(Decode)
+{
+  for (size_t nAppMetaInfo : {0, 2}) {
+    Block wire = makeDataWire(nAppMetaInfo);
+    std::string suffix = ", " + std::to_string(nAppMetaInfo) + " AppMetaInfo";
+
+    report("Data decode, Name only" + suffix, [&] {
+      Block received(wire.getBuffer(), wire.begin(), wire.end(), false);
+      Data data(received);
+      BOOST_CHECK_EQUAL(data.getName().size(), 3);
+    });
+
+    report("Data decode, all fields" + suffix, [&] {
+      Block received(wire.getBuffer(), wire.begin(), wire.end(), false);
+      Data data(received);
+      BOOST_CHECK_EQUAL(data.getMetaInfo().getAppMetaInfo().size(), nAppMetaInfo);
+      BOOST_CHECK(data.getSignature().hasKeyLocator());
+    });
+
+    report("Data decode and re-encode with new Name" + suffix, [&] {
+      Block received(wire.getBuffer(), wire.begin(), wire.end(), false);
+      Data data(received);
+      data.setName("/benchmark/data/footprint/renamed");
+      BOOST_CHECK_GT(data.wireEncode().size(), wire.size());
+    });
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Face InterestFilter Benchmark
+
+#include "face.hpp"
+#include "util/dummy-client-face.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+#include "unit-tests/unit-test-time-fixture.hpp"
+
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+const size_t N_FILTERS = 1000;
+const size_t N_INTERESTS = 10000;
+
+class FaceInterestFilterFixture : public UnitTestTimeFixture
+{
+public:
+  FaceInterestFilterFixture()
+    : face(util::makeDummyClientFace(io, {false, false}))
+    , nDispatched(0)
+  {
+    // per-user filters, half of which also have a regular expression
+    for (size_t i = 0; i < N_FILTERS; ++i) {
+      Name prefix = Name("/benchmark/user").appendNumber(i);
+      auto onInterest = [this] (const InterestFilter&, const Interest&) { ++nDispatched; };
+      if (i % 2 == 0) {
+        face->setInterestFilter(InterestFilter(prefix), onInterest);
+      }
+      else {
+        face->setInterestFilter(InterestFilter(prefix, "<app><>*"), onInterest);
+      }
+    }
+    advanceClocks(time::milliseconds(1));
+
+    for (size_t i = 0; i < N_INTERESTS; ++i) {
+      Name name = Name("/benchmark/user").appendNumber(i % N_FILTERS).append("app").appendNumber(i);
+      interests.push_back(make_shared<Interest>(name));
+    }
+  }
+
+protected:
+  shared_ptr<util::DummyClientFace> face;
+  size_t nDispatched;
+  std::vector<shared_ptr<Interest>> interests;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FaceInterestFilterBenchmark, FaceInterestFilterFixture)
+
+BOOST_AUTO_TEST_CASE(Dispatch)
+{
+  auto duration = timedExecute([&] {
+    for (const auto& interest : interests) {
+      face->receive(*interest);
+    }
+    advanceClocks(time::milliseconds(1));
+  });
+  std::cout << "Dispatch " << N_INTERESTS << " Interests to " << N_FILTERS << " filters: "
+            << duration << ", " << duration.count() / N_INTERESTS << " ns/Interest" << std::endl;
+
+  BOOST_CHECK_EQUAL(nDispatched, N_INTERESTS);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Face Pending Interest Table Benchmark
+
+#include "face.hpp"
+#include "util/dummy-client-face.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+#include "unit-tests/unit-test-time-fixture.hpp"
+#include "unit-tests/make-interest-data.hpp"
+
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+const size_t N_PENDING_INTERESTS = 10000;
+
+class FacePitFixture : public UnitTestTimeFixture
+{
+public:
+  FacePitFixture()
+    : face(util::makeDummyClientFace(io, {false, false}))
+    , nSatisfied(0)
+  {
+    for (size_t i = 0; i < N_PENDING_INTERESTS; ++i) {
+      face->expressInterest(Interest(Name("/benchmark/pit").appendNumber(i), time::seconds(100)),
+                            [this] (const Interest&, const Data&) { ++nSatisfied; },
+                            [] (const Interest&) {});
+    }
+    advanceClocks(time::milliseconds(1));
+
+    for (size_t i = 0; i < N_PENDING_INTERESTS; ++i) {
+      data.push_back(util::makeData(Name("/benchmark/pit").appendNumber(i).append("segment")));
+      unsolicitedData.push_back(util::makeData(Name("/benchmark/other").appendNumber(i)));
+    }
+  }
+
+  static void
+  report(const std::string& name, size_t nPackets, boost::chrono::nanoseconds duration)
+  {
+    std::cout << name << ": " << nPackets << " in " << duration << ", "
+              << duration.count() / nPackets << " ns/Data" << std::endl;
+  }
+
+protected:
+  shared_ptr<util::DummyClientFace> face;
+  size_t nSatisfied;
+  std::vector<shared_ptr<Data>> data;
+  std::vector<shared_ptr<Data>> unsolicitedData;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FacePitBenchmark, FacePitFixture)
+
+BOOST_AUTO_TEST_CASE(UnsolicitedData)
+{
+  BOOST_REQUIRE_EQUAL(face->getNPendingInterests(), N_PENDING_INTERESTS);
+
+  auto duration = timedExecute([&] {
+    for (const auto& d : unsolicitedData) {
+      face->receive(*d);
+    }
+    advanceClocks(time::milliseconds(1));
+  });
+  report("Unsolicited Data, " + std::to_string(N_PENDING_INTERESTS) + " pending Interests",
+         unsolicitedData.size(), duration);
+
+  BOOST_CHECK_EQUAL(nSatisfied, 0);
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), N_PENDING_INTERESTS);
+}
+
+BOOST_AUTO_TEST_CASE(SatisfyAll)
+{
+  BOOST_REQUIRE_EQUAL(face->getNPendingInterests(), N_PENDING_INTERESTS);
+
+  auto duration = timedExecute([&] {
+    // reverse order, so that the matching Interest is never at the front of the table
+    for (auto d = data.rbegin(); d != data.rend(); ++d) {
+      face->receive(**d);
+    }
+    advanceClocks(time::milliseconds(1));
+  });
+  report("Satisfy " + std::to_string(N_PENDING_INTERESTS) + " pending Interests",
+         data.size(), duration);
+
+  BOOST_CHECK_EQUAL(nSatisfied, N_PENDING_INTERESTS);
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
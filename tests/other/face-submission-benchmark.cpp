@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Face Submission Benchmark
+
+#include "face.hpp"
+#include "util/dummy-client-face.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+#include "unit-tests/unit-test-time-fixture.hpp"
+#include "unit-tests/make-interest-data.hpp"
+
+#include <boost/chrono/chrono_io.hpp>
+#include <iostream>
+#include <thread>
+
+namespace ndn {
+namespace tests {
+
+const size_t N_DATA = 100000;
+const size_t CONTENT_SIZE = 1024;
+const size_t MAX_BATCH_SIZE = 64;
+
+class FaceSubmissionFixture : public UnitTestTimeFixture
+{
+public:
+  FaceSubmissionFixture()
+    : face(util::makeDummyClientFace(io, {false, false}))
+    , content(CONTENT_SIZE, 0xBB)
+    , nSent(0)
+  {
+    face->onSendData.connect([this] (const Data&) { ++nSent; });
+  }
+
+  /** \brief build, sign and encode the i-th Data packet
+   */
+  shared_ptr<Data>
+  makeData(size_t i) const
+  {
+    shared_ptr<Data> data = make_shared<Data>(Name("/benchmark/submission").appendNumber(i));
+    data->setContent(content.data(), content.size());
+    return util::signData(data);
+  }
+
+  /** \brief publish N_DATA packets from \p nProducers threads, the face thread only draining
+   *         the submission queue
+   */
+  boost::chrono::nanoseconds
+  submitFromThreads(size_t nProducers)
+  {
+    nSent = 0;
+    return timedExecute([&] {
+      std::vector<std::thread> producers;
+      for (size_t i = 0; i < nProducers; ++i) {
+        producers.emplace_back([this, i, nProducers] {
+            for (size_t j = i; j < N_DATA; j += nProducers) {
+              face->submitData(*makeData(j));
+            }
+          });
+      }
+
+      while (nSent < N_DATA) {
+        if (face->processSubmissions(MAX_BATCH_SIZE) == 0) {
+          std::this_thread::yield();
+        }
+        advanceClocks(time::nanoseconds(1));
+      }
+
+      for (auto& producer : producers) {
+        producer.join();
+      }
+    });
+  }
+
+  static void
+  report(const std::string& name, boost::chrono::nanoseconds duration)
+  {
+    std::cout << name << ": " << N_DATA << " Data in " << duration << ", "
+              << duration.count() / N_DATA << " ns/Data, "
+              << N_DATA * 1000000000.0 / duration.count() << " Data/s" << std::endl;
+  }
+
+protected:
+  shared_ptr<util::DummyClientFace> face;
+  std::vector<uint8_t> content;
+  size_t nSent;
+};
+
+BOOST_FIXTURE_TEST_SUITE(FaceSubmissionBenchmark, FaceSubmissionFixture)
+
+BOOST_AUTO_TEST_CASE(FaceThreadOnly)
+{
+  auto duration = timedExecute([&] {
+    for (size_t i = 0; i < N_DATA; ++i) {
+      face->put(*makeData(i));
+      if (i % MAX_BATCH_SIZE == MAX_BATCH_SIZE - 1) {
+        advanceClocks(time::nanoseconds(1));
+      }
+    }
+    advanceClocks(time::nanoseconds(1));
+  });
+  report("Encode and put on the face thread", duration);
+
+  BOOST_CHECK_EQUAL(nSent, N_DATA);
+}
+
+BOOST_AUTO_TEST_CASE(Producers)
+{
+  size_t maxProducers = std::max(std::thread::hardware_concurrency(), 2u);
+  for (size_t nProducers = 1; nProducers <= maxProducers; nProducers *= 2) {
+    auto duration = submitFromThreads(nProducers);
+    report("Submit from " + std::to_string(nProducers) + " producer threads", duration);
+
+    BOOST_CHECK_EQUAL(nSent, N_DATA);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
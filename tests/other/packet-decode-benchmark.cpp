@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Packet Decode Benchmark
+
+#include "interest.hpp"
+#include "data.hpp"
+#include "encoding/block-helpers.hpp"
+#include "security/digest-sha256.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+const int N_ITERATIONS = 100000;
+
+class PacketDecodeFixture
+{
+public:
+  PacketDecodeFixture()
+  {
+    Interest interest("/benchmark/packet/decode/interest");
+    interest.setMinSuffixComponents(1)
+            .setMaxSuffixComponents(3)
+            .setMustBeFresh(true)
+            .setPublisherPublicKeyLocator(KeyLocator("/benchmark/key/locator"))
+            .setExclude(Exclude().excludeBefore(name::Component("a"))
+                                 .excludeOne(name::Component("b")));
+    interest.setNodeId(1)
+            .setHomeNetwork(2)
+            .setPreferredLocation(3);
+    interest.setNonce(1);
+    interestWire = interest.wireEncode();
+
+    Data data("/benchmark/packet/decode/data");
+    data.setFreshnessPeriod(time::seconds(10));
+    data.setContent(reinterpret_cast<const uint8_t*>("payload"), 7);
+    DigestSha256 signature;
+    signature.setKeyLocator(KeyLocator("/benchmark/key/locator"));
+    data.setSignature(signature);
+    data.setSignatureValue(makeBinaryBlock(tlv::SignatureValue,
+                                           reinterpret_cast<const uint8_t*>("sigvalue"), 8));
+    dataWire = data.wireEncode();
+  }
+
+  /** \brief copy of the wire without parsed sub-elements, as if just received
+   */
+  static Block
+  freshWire(const Block& wire)
+  {
+    return Block(wire.getBuffer(), wire.begin(), wire.end(), false);
+  }
+
+  static void
+  report(const std::string& name, boost::chrono::nanoseconds duration)
+  {
+    std::cout << name << ": " << N_ITERATIONS << " in " << duration << ", "
+              << duration.count() / N_ITERATIONS << " ns/op" << std::endl;
+  }
+
+protected:
+  Block interestWire;
+  Block dataWire;
+};
+
+BOOST_FIXTURE_TEST_SUITE(PacketDecodeBenchmark, PacketDecodeFixture)
+
+BOOST_AUTO_TEST_CASE(InterestNameOnly)
+{
+  size_t nComponents = 0;
+  auto duration = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      Interest interest(freshWire(interestWire));
+      nComponents += interest.getName().size();
+    }
+  });
+  report("Interest decode, Name only", duration);
+  BOOST_CHECK_EQUAL(nComponents, static_cast<size_t>(4 * N_ITERATIONS));
+}
+
+BOOST_AUTO_TEST_CASE(InterestAllFields)
+{
+  size_t nComponents = 0;
+  auto duration = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      Interest interest(freshWire(interestWire));
+      nComponents += interest.getName().size() + interest.getExclude().size() +
+                     interest.getPDRMStrategySelectors().getNodeId();
+    }
+  });
+  report("Interest decode, all fields", duration);
+  BOOST_CHECK_GT(nComponents, 0);
+}
+
+BOOST_AUTO_TEST_CASE(DataNameOnly)
+{
+  size_t nComponents = 0;
+  auto duration = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      Data data(freshWire(dataWire));
+      nComponents += data.getName().size();
+    }
+  });
+  report("Data decode, Name only", duration);
+  BOOST_CHECK_EQUAL(nComponents, static_cast<size_t>(4 * N_ITERATIONS));
+}
+
+BOOST_AUTO_TEST_CASE(DataAllFields)
+{
+  size_t nComponents = 0;
+  auto duration = timedExecute([&] {
+    for (int i = 0; i < N_ITERATIONS; ++i) {
+      Data data(freshWire(dataWire));
+      nComponents += data.getName().size() + data.getFreshnessPeriod().count() +
+                     data.getSignature().getKeyLocator().getName().size();
+    }
+  });
+  report("Data decode, all fields", duration);
+  BOOST_CHECK_GT(nComponents, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
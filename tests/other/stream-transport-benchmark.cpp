@@ -0,0 +1,161 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Stream Transport Benchmark
+
+#include "transport/stream-transport.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/chrono/chrono_io.hpp>
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+typedef boost::asio::local::stream_protocol Protocol;
+
+/** \brief minimal stand-in for the transport that owns a StreamTransportImpl
+ */
+class LoopbackTransport
+{
+public:
+  void
+  receive(const std::vector<Block>& wires)
+  {
+  }
+
+  void
+  close()
+  {
+  }
+
+public:
+  bool m_isConnected = true;
+  bool m_isExpectingData = false;
+  SendQueueMonitor m_sendQueueMonitor;
+};
+
+class LoopbackImpl : public StreamTransportImpl<LoopbackTransport, Protocol>
+{
+public:
+  LoopbackImpl(LoopbackTransport& transport, boost::asio::io_service& ioService)
+    : StreamTransportImpl<LoopbackTransport, Protocol>(transport, ioService)
+  {
+  }
+
+  Protocol::socket&
+  getSocket()
+  {
+    return m_socket;
+  }
+};
+
+class StreamTransportFixture
+{
+protected:
+  StreamTransportFixture()
+    : impl(transport, io)
+    , peer(io)
+    , nReceivedBytes(0)
+  {
+    boost::asio::local::connect_pair(impl.getSocket(), peer);
+
+    std::vector<uint8_t> payload(PAYLOAD_SIZE, 0xBB);
+    packet = makeBinaryBlock(tlv::Content, payload.data(), payload.size());
+  }
+
+  void
+  drain()
+  {
+    peer.async_read_some(boost::asio::buffer(sink),
+                         [this] (const boost::system::error_code& error, size_t nBytes) {
+                           nReceivedBytes += nBytes;
+                           if (!error && nReceivedBytes < expectedBytes)
+                             drain();
+                         });
+  }
+
+  /** \brief send N_PACKETS in bursts of \p burstSize, then run until the peer got all bytes
+   */
+  void
+  run(const std::string& name, size_t burstSize)
+  {
+    expectedBytes = N_PACKETS * packet.size();
+    drain();
+
+    auto duration = timedExecute([&] {
+      for (size_t i = 0; i < N_PACKETS; i += burstSize) {
+        for (size_t j = 0; j < burstSize; ++j) {
+          impl.send(packet);
+        }
+        io.poll();
+      }
+      while (nReceivedBytes < expectedBytes) {
+        io.run_one();
+      }
+    });
+
+    BOOST_CHECK_EQUAL(nReceivedBytes, expectedBytes);
+    std::cout << name << ", bursts of " << burstSize << ": "
+              << N_PACKETS << " packets in " << duration << ", "
+              << duration.count() / N_PACKETS << " ns/packet, "
+              << static_cast<double>(impl.getNWrites()) / N_PACKETS << " writes/packet, "
+              << expectedBytes * 1000.0 / duration.count() << " MB/s" << std::endl;
+  }
+
+protected:
+  static const size_t N_PACKETS = 200000;
+  static const size_t PAYLOAD_SIZE = 1000;
+
+  boost::asio::io_service io;
+  LoopbackTransport transport;
+  LoopbackImpl impl;
+  Protocol::socket peer;
+  Block packet;
+
+  uint8_t sink[1 << 16];
+  size_t nReceivedBytes;
+  size_t expectedBytes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(StreamTransportBenchmark, StreamTransportFixture)
+
+BOOST_AUTO_TEST_CASE(OneBlockPerWrite)
+{
+  impl.setWriteBatchLimits(MAX_NDN_PACKET_SIZE, 1);
+  run("One block per write", 32);
+}
+
+BOOST_AUTO_TEST_CASE(CoalescedWrites)
+{
+  run("Coalesced writes", 32);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx TCP Transport Benchmark
+
+#include "transport/tcp-transport.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include "boost-test.hpp"
+#include "timed-execute.hpp"
+
+#include <boost/chrono/chrono_io.hpp>
+#include <iostream>
+
+namespace ndn {
+namespace tests {
+
+/** \brief sends bursts of packets through a TcpTransport to a peer socket on the loopback
+ *         interface, which discards them
+ */
+class TcpTransportFixture
+{
+protected:
+  TcpTransportFixture()
+    : acceptor(io, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0))
+    , peer(io)
+    , nReceivedBytes(0)
+  {
+  }
+
+  void
+  drain()
+  {
+    peer.async_read_some(boost::asio::buffer(sink),
+                         [this] (const boost::system::error_code& error, size_t nBytes) {
+                           nReceivedBytes += nBytes;
+                           if (!error && nReceivedBytes < expectedBytes)
+                             drain();
+                         });
+  }
+
+  /** \brief send N_BYTES in packets of \p payloadSize bytes, in bursts of BURST_SIZE,
+   *         then run until the peer got all bytes
+   */
+  void
+  run(const std::string& name, const TcpTransport::Options& options, size_t payloadSize)
+  {
+    std::vector<uint8_t> payload(payloadSize, 0xBB);
+    Block packet = makeBinaryBlock(tlv::Content, payload.data(), payload.size());
+    const size_t nPackets = N_BYTES / packet.size();
+
+    bool isAccepted = false;
+    acceptor.async_accept(peer, [&] (const boost::system::error_code& error) {
+      BOOST_REQUIRE(!error);
+      isAccepted = true;
+    });
+
+    TcpTransport transport("127.0.0.1", std::to_string(acceptor.local_endpoint().port()),
+                           options);
+    transport.connect(io, Transport::ReceiveCallback([] (const Block&) {}));
+    while (!isAccepted || !transport.isConnected()) {
+      io.run_one();
+    }
+
+    nReceivedBytes = 0;
+    expectedBytes = nPackets * packet.size();
+    drain();
+
+    auto duration = timedExecute([&] {
+      for (size_t i = 0; i < nPackets; i += BURST_SIZE) {
+        for (size_t j = 0; j < BURST_SIZE && i + j < nPackets; ++j) {
+          transport.send(packet);
+        }
+        io.poll();
+      }
+      while (nReceivedBytes < expectedBytes) {
+        io.run_one();
+      }
+    });
+
+    BOOST_CHECK_EQUAL(nReceivedBytes, expectedBytes);
+    std::cout << name << ", " << packet.size() << "-byte packets: "
+              << nPackets << " packets in " << duration << ", "
+              << duration.count() / nPackets << " ns/packet, "
+              << expectedBytes * 1000.0 / duration.count() << " MB/s" << std::endl;
+
+    transport.close();
+    peer.close();
+  }
+
+  void
+  run(const std::string& name, const TcpTransport::Options& options)
+  {
+    run(name, options, 1000);
+    run(name, options, 8000);
+  }
+
+protected:
+  static const size_t N_BYTES = 400 * 1000 * 1000;
+  static const size_t BURST_SIZE = 32;
+
+  boost::asio::io_service io;
+  boost::asio::ip::tcp::acceptor acceptor;
+  boost::asio::ip::tcp::socket peer;
+
+  uint8_t sink[1 << 16];
+  size_t nReceivedBytes;
+  size_t expectedBytes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TcpTransportBenchmark, TcpTransportFixture)
+
+BOOST_AUTO_TEST_CASE(Nagle)
+{
+  TcpTransport::Options options;
+  options.noDelay = false;
+  run("Nagle", options);
+}
+
+BOOST_AUTO_TEST_CASE(NoDelay)
+{
+  run("TCP_NODELAY", TcpTransport::Options());
+}
+
+BOOST_AUTO_TEST_CASE(NoDelayCork)
+{
+  TcpTransport::Options options;
+  options.cork = true;
+  run("TCP_NODELAY and TCP_CORK", options);
+}
+
+BOOST_AUTO_TEST_CASE(LargeBuffers)
+{
+  TcpTransport::Options options;
+  options.sendBufferSize = 4 * 1024 * 1024;
+  options.receiveBufferSize = 4 * 1024 * 1024;
+  options.writeBatchSize = 256 * 1024;
+  run("4 MB socket buffers, 256 KB writes", options);
+}
+
+BOOST_AUTO_TEST_CASE(ZeroCopy)
+{
+  TcpTransport::Options options;
+  options.sendBufferSize = 4 * 1024 * 1024;
+  options.receiveBufferSize = 4 * 1024 * 1024;
+  options.writeBatchSize = 256 * 1024;
+  options.zeroCopyThreshold = 64 * 1024;
+  run("4 MB socket buffers, 256 KB MSG_ZEROCOPY writes", options);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
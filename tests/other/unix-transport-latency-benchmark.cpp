@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Unix Transport Latency Benchmark
+
+#include "transport/unix-transport.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/chrono/system_clocks.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+namespace ndn {
+namespace tests {
+
+const size_t N_PACKETS = 20000;
+
+static uint64_t
+getNow()
+{
+  return boost::chrono::duration_cast<boost::chrono::nanoseconds>(
+           boost::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** \brief a forwarder stand-in that sends timestamped packets from another thread,
+ *         while the UnixTransport measures the one-way latency of each packet
+ */
+class UnixTransportLatencyFixture
+{
+protected:
+  UnixTransportLatencyFixture()
+    : socketPath((boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path()).string())
+    , acceptor(io, socketPath)
+    , peer(io)
+    , transport(socketPath)
+  {
+    latencies.reserve(N_PACKETS);
+  }
+
+  ~UnixTransportLatencyFixture()
+  {
+    boost::filesystem::remove(socketPath);
+  }
+
+  /** \brief send N_PACKETS in bursts of \p burstSize, pausing \p gap between bursts
+   */
+  void
+  run(const std::string& name, const time::nanoseconds& busyPollBudget,
+      size_t burstSize, const time::nanoseconds& gap)
+  {
+    bool isAccepted = false;
+    acceptor.async_accept(peer, [&] (const boost::system::error_code& error) {
+      BOOST_REQUIRE(!error);
+      isAccepted = true;
+    });
+
+    transport.setBusyPoll(busyPollBudget);
+    transport.connect(io, [this] (const std::vector<Block>& wires) {
+      uint64_t now = getNow();
+      for (const Block& wire : wires) {
+        latencies.push_back(now - readNonNegativeInteger(wire));
+      }
+    });
+    while (!isAccepted || !transport.isConnected()) {
+      io.run_one();
+    }
+
+    std::thread sender([&] {
+      for (size_t i = 0; i < N_PACKETS; i += burstSize) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(gap.count()));
+        for (size_t j = 0; j < burstSize; ++j) {
+          Block packet = makeNonNegativeIntegerBlock(tlv::Content, getNow());
+          boost::asio::write(peer, boost::asio::buffer(packet.wire(), packet.size()));
+        }
+      }
+    });
+    while (latencies.size() < N_PACKETS) {
+      io.run_one();
+    }
+    sender.join();
+    transport.close();
+
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [this] (double p) {
+      return latencies[std::min(latencies.size() - 1,
+                                static_cast<size_t>(p / 100 * latencies.size()))];
+    };
+    std::cout << name << ", bursts of " << burstSize << " every " << gap << ": "
+              << "p50 " << percentile(50) << " ns, "
+              << "p90 " << percentile(90) << " ns, "
+              << "p99 " << percentile(99) << " ns, "
+              << "p99.9 " << percentile(99.9) << " ns" << std::endl;
+  }
+
+protected:
+  boost::asio::io_service io;
+  std::string socketPath;
+  boost::asio::local::stream_protocol::acceptor acceptor;
+  boost::asio::local::stream_protocol::socket peer;
+  UnixTransport transport;
+  std::vector<uint64_t> latencies;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UnixTransportLatencyBenchmark, UnixTransportLatencyFixture)
+
+BOOST_AUTO_TEST_CASE(ReactorPaced)
+{
+  run("Reactor", time::nanoseconds::zero(), 1, time::microseconds(20));
+}
+
+BOOST_AUTO_TEST_CASE(BusyPollPaced)
+{
+  run("Busy poll", time::microseconds(100), 1, time::microseconds(20));
+}
+
+BOOST_AUTO_TEST_CASE(ReactorBursts)
+{
+  run("Reactor", time::nanoseconds::zero(), 16, time::microseconds(100));
+}
+
+BOOST_AUTO_TEST_CASE(BusyPollBursts)
+{
+  run("Busy poll", time::microseconds(200), 16, time::microseconds(100));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -369,6 +369,111 @@ BOOST_FIXTURE_TEST_CASE(Decode, TestDataFixture)
   BOOST_REQUIRE_EQUAL(signatureVerified, true);
 }
 
+BOOST_AUTO_TEST_CASE(DecodeThenModify)
+{
+  Block dataBlock(Data1, sizeof(Data1));
+
+  // MetaInfo and Signature are decoded lazily, modifying the Name must not lose them
+  ndn::Data d(dataBlock);
+  d.setName("/another/prefix");
+  BOOST_CHECK_EQUAL(d.hasWire(), false);
+
+  BOOST_CHECK_EQUAL(d.getName().toUri(), "/another/prefix");
+  BOOST_CHECK_EQUAL(d.getFreshnessPeriod(), time::seconds(10));
+  BOOST_CHECK_EQUAL(d.getSignature().getType(), static_cast<uint32_t>(Signature::Sha256WithRsa));
+  BOOST_CHECK_EQUAL(d.getSignature().getKeyLocator().getName().toUri(), "/test/key/locator");
+  BOOST_CHECK_EQUAL(d.getSignature().getValue().value_size(), 128);
+
+  ndn::Data d2(d.wireEncode());
+  BOOST_CHECK_EQUAL(d, d2);
+}
+
+BOOST_AUTO_TEST_CASE(DecodeMalformedMetaInfoAndSignatureInfo)
+{
+  // MetaInfo and SignatureInfo are decoded on first access, but malformed ones are rejected
+  // by wireDecode
+  const uint8_t badContentType[] = {
+    0x06, 0x15,
+      0x07, 0x03, 0x08, 0x01, 0x61,
+      0x14, 0x05,
+        0x18, 0x03, 0x00, 0x00, 0x01, // 3-octet NonNegativeInteger
+      0x15, 0x00,
+      0x16, 0x03, 0x1b, 0x01, 0x00,
+      0x17, 0x00
+  };
+  BOOST_CHECK_THROW(ndn::Data(Block(badContentType, sizeof(badContentType))), tlv::Error);
+
+  const uint8_t missingSignatureType[] = {
+    0x06, 0x0f,
+      0x07, 0x03, 0x08, 0x01, 0x61,
+      0x14, 0x00,
+      0x15, 0x00,
+      0x16, 0x02, 0x1c, 0x00, // KeyLocator without SignatureType
+      0x17, 0x00
+  };
+  BOOST_CHECK_THROW(ndn::Data(Block(missingSignatureType, sizeof(missingSignatureType))),
+                    tlv::Error);
+
+  const uint8_t finalBlockIdNotComponent[] = {
+    0x06, 0x15,
+      0x07, 0x03, 0x08, 0x01, 0x61,
+      0x14, 0x05,
+        0x1a, 0x03, 0x1b, 0x01, 0x00, // FinalBlockId holding a SignatureType
+      0x15, 0x00,
+      0x16, 0x03, 0x1b, 0x01, 0x00,
+      0x17, 0x00
+  };
+  BOOST_CHECK_THROW(ndn::Data(Block(finalBlockIdNotComponent, sizeof(finalBlockIdNotComponent))),
+                    tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(CopyOnWrite)
+{
+  Block dataBlock(Data1, sizeof(Data1));
+
+  ndn::Data a(dataBlock);
+  ndn::Data b(a);
+  BOOST_CHECK_EQUAL(a.wireEncode().wire(), b.wireEncode().wire());
+  // MetaInfo and Signature were decoded before the core was shared
+  BOOST_CHECK_EQUAL(&a.getMetaInfo(), &b.getMetaInfo());
+  BOOST_CHECK_EQUAL(&a.getSignature(), &b.getSignature());
+
+  b.setFreshnessPeriod(time::seconds(1));
+  BOOST_CHECK_EQUAL(a.getFreshnessPeriod(), time::seconds(10));
+  BOOST_CHECK_EQUAL(b.getFreshnessPeriod(), time::seconds(1));
+  BOOST_CHECK_EQUAL(a.hasWire(), true);
+  BOOST_CHECK_EQUAL(b.hasWire(), false);
+
+  ndn::Data c(a);
+  BOOST_CHECK_EQUAL(c.getFullName(), a.getFullName());
+  c.setUnsolicited(true);
+  BOOST_CHECK_EQUAL(a.getUnsolicited(), false);
+}
+
+BOOST_AUTO_TEST_CASE(Clone)
+{
+  Block dataBlock(Data1, sizeof(Data1));
+
+  ndn::Data a(dataBlock);
+  ndn::Data copy(a);
+  ndn::Data clone = a.clone();
+
+  // a copy shares the encoding, a clone has its own that refers to the same bytes
+  BOOST_CHECK_EQUAL(&copy.wireEncode(), &a.wireEncode());
+  BOOST_CHECK_NE(&clone.wireEncode(), &a.wireEncode());
+  BOOST_CHECK_EQUAL(clone.getFullName(), a.getFullName());
+
+  // the encoding cached later by a copy of an unencoded packet is not seen by the original
+  ndn::Data b("/b");
+  b.setSignature(SignatureSha256WithRsa());
+  b.setSignatureValue(makeEmptyBlock(tlv::SignatureValue));
+  ndn::Data bCopy(b);
+  bCopy.wireEncode();
+  BOOST_CHECK_EQUAL(b.hasWire(), false);
+  BOOST_CHECK_EQUAL(clone.wireEncode().wire(), a.wireEncode().wire());
+  BOOST_CHECK_EQUAL(clone, a);
+}
+
 BOOST_FIXTURE_TEST_CASE(Encode, TestDataFixture)
 {
   // manual data packet creation for now
@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "detail/interest-filter-table.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/mpl/vector.hpp>
+
+namespace ndn {
+namespace tests {
+
+/**
+ * @brief Hash that puts every prefix into the same bucket
+ */
+class CollidingPrefixHash
+{
+public:
+  static size_t
+  compute(const Name&, size_t)
+  {
+    return 0;
+  }
+
+  static size_t
+  compute(const Name&)
+  {
+    return 0;
+  }
+
+  static size_t
+  extend(size_t, const name::Component&)
+  {
+    return 0;
+  }
+};
+
+template<typename PrefixHash>
+class InterestFilterTableFixture
+{
+public:
+  shared_ptr<InterestFilterRecord>
+  add(const InterestFilter& filter)
+  {
+    auto record = make_shared<InterestFilterRecord>(filter, InterestFilterRecord::InterestCallback());
+    table.push_back(record);
+    return record;
+  }
+
+  std::vector<shared_ptr<InterestFilterRecord>>
+  find(const Name& name) const
+  {
+    return table.findMatches(name);
+  }
+
+public:
+  InterestFilterTable<PrefixHash> table;
+};
+
+typedef boost::mpl::vector<InterestFilterTableFixture<NamePrefixHash>,
+                           InterestFilterTableFixture<CollidingPrefixHash>> Fixtures;
+
+BOOST_AUTO_TEST_SUITE(DetailInterestFilterTable)
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(PrefixMatch, T, Fixtures, T)
+{
+  auto a = this->add(InterestFilter("/A"));
+  auto ab = this->add(InterestFilter("/A/B"));
+
+  BOOST_CHECK(this->find("/A/B/C") == (std::vector<shared_ptr<InterestFilterRecord>>{a, ab}));
+  BOOST_CHECK(this->find("/A/C") == (std::vector<shared_ptr<InterestFilterRecord>>{a}));
+  BOOST_CHECK(this->find("/A") == (std::vector<shared_ptr<InterestFilterRecord>>{a}));
+  BOOST_CHECK(this->find("/B/A").empty());
+  BOOST_CHECK(this->find("/").empty());
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(RegexUnderPrefix, T, Fixtures, T)
+{
+  auto regex = this->add(InterestFilter("/A", "<><b>"));
+
+  BOOST_CHECK(this->find("/A/x/b") == (std::vector<shared_ptr<InterestFilterRecord>>{regex}));
+  BOOST_CHECK(this->find("/A/x/c").empty());
+  BOOST_CHECK(this->find("/A/x/b/c").empty());
+  // same suffix under another prefix
+  BOOST_CHECK(this->find("/B/x/b").empty());
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(DispatchOrder, T, Fixtures, T)
+{
+  // matches are returned in the order the filters were added, not by prefix length
+  auto abc = this->add(InterestFilter("/A/B/C"));
+  auto root = this->add(InterestFilter("/"));
+  auto ab = this->add(InterestFilter("/A/B"));
+  this->add(InterestFilter("/A/D"));
+  auto abRegex = this->add(InterestFilter("/A/B", "<C><>*"));
+  auto a = this->add(InterestFilter("/A"));
+
+  BOOST_CHECK(this->find("/A/B/C/D") ==
+              (std::vector<shared_ptr<InterestFilterRecord>>{abc, root, ab, abRegex, a}));
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(UnsetAndReset, T, Fixtures, T)
+{
+  auto a = this->add(InterestFilter("/A"));
+  auto ab = this->add(InterestFilter("/A/B"));
+  auto ab2 = this->add(InterestFilter("/A/B"));
+  BOOST_CHECK_EQUAL(this->table.size(), 3);
+
+  this->table.remove(ab);
+  BOOST_CHECK_EQUAL(this->table.size(), 2);
+  BOOST_CHECK(this->find("/A/B") == (std::vector<shared_ptr<InterestFilterRecord>>{a, ab2}));
+
+  // removing twice has no effect
+  this->table.remove(ab);
+  BOOST_CHECK_EQUAL(this->table.size(), 2);
+
+  // a filter that is set again is dispatched after the existing ones
+  this->table.push_back(ab);
+  BOOST_CHECK_EQUAL(this->table.size(), 3);
+  BOOST_CHECK(this->find("/A/B") == (std::vector<shared_ptr<InterestFilterRecord>>{a, ab2, ab}));
+
+  BOOST_CHECK(this->table.removeById(reinterpret_cast<const InterestFilterId*>(a.get())));
+  BOOST_CHECK(!this->table.removeById(reinterpret_cast<const InterestFilterId*>(a.get())));
+  this->table.remove(ab2);
+  this->table.remove(ab);
+  BOOST_CHECK(this->table.empty());
+  BOOST_CHECK(this->find("/A/B").empty());
+}
+
+BOOST_AUTO_TEST_CASE(HashCollision)
+{
+  InterestFilterTableFixture<CollidingPrefixHash> f;
+  auto ab = f.add(InterestFilter("/A/B"));
+  auto cd = f.add(InterestFilter("/C/D"));
+  auto root = f.add(InterestFilter("/"));
+
+  // every prefix of the name finds all records, but each match is returned once
+  BOOST_CHECK(f.find("/A/B/C/D") == (std::vector<shared_ptr<InterestFilterRecord>>{ab, root}));
+  BOOST_CHECK(f.find("/C/D") == (std::vector<shared_ptr<InterestFilterRecord>>{cd, root}));
+
+  // removal picks the right record among those with the same hash
+  f.table.remove(cd);
+  BOOST_CHECK(f.find("/C/D") == (std::vector<shared_ptr<InterestFilterRecord>>{root}));
+  BOOST_CHECK(f.find("/A/B") == (std::vector<shared_ptr<InterestFilterRecord>>{ab, root}));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // DetailInterestFilterTable
+
+} // namespace tests
+} // namespace ndn
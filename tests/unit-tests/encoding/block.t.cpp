@@ -334,6 +334,35 @@ BOOST_AUTO_TEST_CASE(FromBuffer)
   BOOST_CHECK(!isOk);
 }
 
+BOOST_AUTO_TEST_CASE(FromBufferBounded)
+{
+  const uint8_t TEST_BUFFER[] = {0x00, 0x01, 0xfa, // ok
+                                 0x01, 0x02, 0xfb, 0xfc, // ok, unless truncated
+                                 0x00, 0x00, 0x00};
+  BufferPtr buffer(new Buffer(TEST_BUFFER, sizeof(TEST_BUFFER)));
+
+  bool isOk = false;
+  Block testBlock;
+  std::tie(isOk, testBlock) = Block::fromBuffer(buffer, 0, 3);
+  BOOST_CHECK(isOk);
+  BOOST_CHECK_EQUAL(testBlock.type(), 0);
+  BOOST_CHECK_EQUAL(testBlock.size(), 3);
+  BOOST_CHECK(testBlock.getBuffer() == buffer); // no memory copy
+
+  std::tie(isOk, testBlock) = Block::fromBuffer(buffer, 3, 3);
+  BOOST_CHECK(!isOk);
+
+  std::tie(isOk, testBlock) = Block::fromBuffer(buffer, 3, 4);
+  BOOST_CHECK(isOk);
+  BOOST_CHECK_EQUAL(testBlock.type(), 1);
+  BOOST_CHECK_EQUAL(testBlock.value_size(), 2);
+  BOOST_CHECK_EQUAL(testBlock.value()[1], 0xfc);
+  BOOST_CHECK(testBlock.getBuffer() == buffer);
+
+  std::tie(isOk, testBlock) = Block::fromBuffer(buffer, 7, 0);
+  BOOST_CHECK(!isOk);
+}
+
 BOOST_AUTO_TEST_CASE(FromStream)
 {
   const uint8_t TEST_BUFFER[] = {0x00, 0x01, 0xfa, // ok
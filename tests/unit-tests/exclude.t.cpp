@@ -200,6 +200,19 @@ BOOST_AUTO_TEST_CASE(Malformed)
   };
 
   BOOST_CHECK_THROW(Exclude().wireDecode(Block(WIRE, sizeof(WIRE))), Exclude::Error);
+
+  // validate applies the rules of wireDecode without decoding
+  BOOST_CHECK_THROW(Exclude::validate(Block(NON_EXCLUDE, sizeof(NON_EXCLUDE))), tlv::Error);
+  BOOST_CHECK_THROW(Exclude::validate(Block(EMPTY_EXCLUDE, sizeof(EMPTY_EXCLUDE))),
+                    Exclude::Error);
+  BOOST_CHECK_THROW(Exclude::validate(Block(UNKNOWN_COMP2, sizeof(UNKNOWN_COMP2))),
+                    Exclude::Error);
+  BOOST_CHECK_THROW(Exclude::validate(Block(ANY_ANY, sizeof(ANY_ANY))), Exclude::Error);
+  BOOST_CHECK_THROW(Exclude::validate(Block(WIRE, sizeof(WIRE))), Exclude::Error);
+
+  Exclude valid;
+  valid.excludeOne(name::Component("T")).excludeAfter(name::Component("U"));
+  BOOST_CHECK_NO_THROW(Exclude::validate(valid.wireEncode()));
 }
 
 BOOST_AUTO_TEST_CASE(ImplicitSha256Digest)
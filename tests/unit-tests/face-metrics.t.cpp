@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "face-metrics.hpp"
+
+#include "boost-test.hpp"
+
+#include <sstream>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestFaceMetrics)
+
+BOOST_AUTO_TEST_CASE(HistogramEmpty)
+{
+  LatencyHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMin(), time::nanoseconds::zero());
+  BOOST_CHECK_EQUAL(histogram.getMean(), time::nanoseconds::zero());
+  BOOST_CHECK_EQUAL(histogram.getPercentile(50), time::nanoseconds::zero());
+}
+
+BOOST_AUTO_TEST_CASE(Histogram)
+{
+  LatencyHistogram histogram;
+  for (int i = 1; i <= 100; ++i) {
+    histogram.add(time::microseconds(i));
+  }
+
+  BOOST_CHECK_EQUAL(histogram.getCount(), 100);
+  BOOST_CHECK_EQUAL(histogram.getMin(), time::microseconds(1));
+  BOOST_CHECK_EQUAL(histogram.getMax(), time::microseconds(100));
+  BOOST_CHECK_EQUAL(histogram.getMean(), time::nanoseconds(50500));
+  BOOST_CHECK_EQUAL(histogram.getPercentile(0), time::nanoseconds(1024));
+  BOOST_CHECK_EQUAL(histogram.getPercentile(50), time::nanoseconds(65536));
+  BOOST_CHECK_EQUAL(histogram.getPercentile(100), time::microseconds(100));
+
+  // 1000ns falls in [512, 1024)
+  BOOST_CHECK_EQUAL(histogram.getBucketCount(9), 1);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketUpperBound(9), time::nanoseconds(1024));
+
+  histogram.add(time::nanoseconds(-1));
+  BOOST_CHECK_EQUAL(histogram.getBucketCount(0), 1);
+  BOOST_CHECK_EQUAL(histogram.getMin(), time::nanoseconds::zero());
+
+  histogram.reset();
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getBucketCount(9), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Print)
+{
+  FaceMetrics metrics;
+  metrics.nExpressedInterests = 2;
+  metrics.interestRtt.add(time::milliseconds(1));
+
+  std::ostringstream os;
+  os << metrics;
+  BOOST_CHECK(os.str().find("expressed=2") != std::string::npos);
+  BOOST_CHECK(os.str().find("Interest RTT: count=1") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
@@ -28,6 +28,10 @@
 #include "unit-test-time-fixture.hpp"
 #include "make-interest-data.hpp"
 
+#include <ns3/simulator.h>
+
+#include <thread>
+
 namespace ndn {
 namespace tests {
 
@@ -126,6 +130,229 @@ BOOST_AUTO_TEST_CASE(ExpressInterestTimeout)
   BOOST_CHECK_EQUAL(face->sentDatas.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(DirectDelivery)
+{
+  BOOST_CHECK_EQUAL(face->isDirectDelivery(), false);
+  face->setDirectDelivery(true);
+  BOOST_CHECK_EQUAL(face->isDirectDelivery(), true);
+
+  size_t nData = 0;
+  face->expressInterest(Interest("/Hello/World", time::milliseconds(50)),
+                        [&] (const Interest& i, const Data& d) {
+                          ++nData;
+                          // not re-entered: sent once this callback has returned
+                          face->expressInterest(Interest("/Hello/Again", time::milliseconds(50)),
+                                                bind([]{}), bind([]{}));
+                          BOOST_CHECK_EQUAL(face->sentInterests.size(), 1);
+                        },
+                        bind([] {
+                            BOOST_FAIL("Unexpected timeout");
+                          }));
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 1);
+
+  face->receive(*util::makeData("/Hello/World/!"));
+  BOOST_CHECK_EQUAL(nData, 1);
+
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 2);
+
+  face->put(*util::makeData("/Bye/World"));
+  BOOST_CHECK_EQUAL(face->sentDatas.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(DirectDeliveryAcrossFaces)
+{
+  shared_ptr<DummyClientFace> face2 = makeDummyClientFace(io, {true, true});
+  face->setDirectDelivery(true);
+  face2->setDirectDelivery(true);
+
+  face->expressInterest(Interest("/Hello/World", time::milliseconds(50)),
+                        [&] (const Interest& i, const Data& d) {
+                          // another face does not deliver directly either while a packet
+                          // of this face is being processed
+                          face2->put(*util::makeData("/Bye/World"));
+                          BOOST_CHECK_EQUAL(face2->sentDatas.size(), 0);
+                        },
+                        bind([] {
+                            BOOST_FAIL("Unexpected timeout");
+                          }));
+
+  face->receive(*util::makeData("/Hello/World/!"));
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK_EQUAL(face2->sentDatas.size(), 1);
+
+  face2->put(*util::makeData("/Bye/Again"));
+  BOOST_CHECK_EQUAL(face2->sentDatas.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Metrics)
+{
+  face->expressInterest(Interest("/Hello/World", time::milliseconds(50)),
+                        bind([]{}), bind([]{}));
+  face->expressInterest(Interest("/Bye/World", time::milliseconds(50)),
+                        bind([]{}), bind([]{}));
+  const PendingInterestId* removed =
+    face->expressInterest(Interest("/Removed", time::milliseconds(50)), bind([]{}), bind([]{}));
+  advanceClocks(time::milliseconds(10));
+  face->removePendingInterest(removed);
+
+  face->receive(*util::makeData("/Hello/World/!"));
+  advanceClocks(time::milliseconds(10), 10);
+
+  std::vector<uint64_t> dumped;
+  face->setMetricsDumpCallback(time::milliseconds(100), [&] (const FaceMetrics& metrics) {
+      dumped.push_back(metrics.nExpressedInterests);
+    });
+  advanceClocks(time::milliseconds(10), 25);
+
+  FaceMetrics metrics = face->getMetrics();
+  BOOST_CHECK_EQUAL(metrics.nExpressedInterests, 3);
+  BOOST_CHECK_EQUAL(metrics.nSatisfiedInterests, 1);
+  BOOST_CHECK_EQUAL(metrics.nTimedOutInterests, 1);
+  BOOST_CHECK_EQUAL(metrics.nCancelledInterests, 1);
+  BOOST_CHECK_EQUAL(metrics.nReceivedData, 1);
+  BOOST_CHECK_EQUAL(metrics.interestRtt.getCount(), 1);
+  BOOST_CHECK_GT(metrics.nOutBytes, 0);
+  BOOST_CHECK_EQUAL(dumped.size(), 2);
+
+  face->setMetricsDumpCallback(time::milliseconds(100), nullptr);
+  face->resetMetrics();
+  advanceClocks(time::milliseconds(10), 25);
+  BOOST_CHECK_EQUAL(dumped.size(), 2);
+  BOOST_CHECK_EQUAL(face->getMetrics().nExpressedInterests, 0);
+}
+
+BOOST_AUTO_TEST_CASE(ExpressInterestTimeoutOrder)
+{
+  std::vector<Name> timedOut;
+  auto onData = [] (const Interest&, const Data&) {
+    BOOST_FAIL("Unexpected data");
+  };
+  auto onTimeout = [&] (const Interest& i) {
+    timedOut.push_back(i.getName());
+  };
+
+  face->expressInterest(Interest("/C", time::seconds(70)), onData, onTimeout);
+  face->expressInterest(Interest("/A", time::milliseconds(30)), onData, onTimeout);
+  face->expressInterest(Interest("/D", time::milliseconds(70005)), onData, onTimeout);
+  face->expressInterest(Interest("/B", time::milliseconds(2500)), onData, onTimeout);
+  const PendingInterestId* removed =
+    face->expressInterest(Interest("/E", time::seconds(1)), onData, onTimeout);
+
+  advanceClocks(time::milliseconds(10), 10);
+  BOOST_REQUIRE_EQUAL(timedOut.size(), 1);
+  BOOST_CHECK_EQUAL(timedOut[0], Name("/A"));
+
+  face->removePendingInterest(removed);
+  advanceClocks(time::milliseconds(10), 300);
+  BOOST_REQUIRE_EQUAL(timedOut.size(), 2);
+  BOOST_CHECK_EQUAL(timedOut[1], Name("/B"));
+
+  advanceClocks(time::milliseconds(1), 66899);
+  BOOST_CHECK_EQUAL(timedOut.size(), 2);
+  advanceClocks(time::milliseconds(1), 1);
+  BOOST_REQUIRE_EQUAL(timedOut.size(), 3);
+  BOOST_CHECK_EQUAL(timedOut[2], Name("/C"));
+
+  advanceClocks(time::milliseconds(1), 4);
+  BOOST_CHECK_EQUAL(timedOut.size(), 3);
+  advanceClocks(time::milliseconds(1), 1);
+  BOOST_REQUIRE_EQUAL(timedOut.size(), 4);
+  BOOST_CHECK_EQUAL(timedOut[3], Name("/D"));
+}
+
+BOOST_AUTO_TEST_CASE(ExpressInterestDataMultipleMatches)
+{
+  std::vector<Name> satisfied;
+  auto onData = [&] (const Interest& i, const Data& d) {
+    satisfied.push_back(i.getName());
+  };
+  auto onTimeout = [] (const Interest&) {};
+
+  face->expressInterest(Interest("/A/B", time::milliseconds(50)), onData, onTimeout);
+  face->expressInterest(Interest("/C", time::milliseconds(50)), onData, onTimeout);
+  face->expressInterest(Interest("/A", time::milliseconds(50)), onData, onTimeout);
+  face->expressInterest(Interest("/A/B/C/D", time::milliseconds(50)), onData, onTimeout);
+  face->expressInterest(Interest("/", time::milliseconds(50)), onData, onTimeout);
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 5);
+
+  face->receive(*util::makeData("/A/B/C"));
+  advanceClocks(time::milliseconds(1), 10);
+
+  // every matching Interest is satisfied, in the order they were expressed
+  BOOST_REQUIRE_EQUAL(satisfied.size(), 3);
+  BOOST_CHECK_EQUAL(satisfied[0], Name("/A/B"));
+  BOOST_CHECK_EQUAL(satisfied[1], Name("/A"));
+  BOOST_CHECK_EQUAL(satisfied[2], Name("/"));
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(ExpressInterestsBatch)
+{
+  std::vector<Name> satisfied;
+  size_t nTimeouts = 0;
+  std::vector<Interest> window{Interest("/A/1", time::milliseconds(50)),
+                               Interest("/A/2", time::milliseconds(50)),
+                               Interest("/A/3", time::milliseconds(50))};
+  std::vector<const PendingInterestId*> ids =
+    face->expressInterests(window,
+                           [&] (const Interest& i, const Data&) { satisfied.push_back(i.getName()); },
+                           [&] (const Interest&) { ++nTimeouts; });
+  BOOST_CHECK_EQUAL(ids.size(), 3);
+  advanceClocks(time::milliseconds(1), 10);
+
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 3);
+  BOOST_CHECK_EQUAL(face->sentInterests[0].getName(), Name("/A/1"));
+  BOOST_CHECK_EQUAL(face->sentInterests[2].getName(), Name("/A/3"));
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 3);
+
+  face->removePendingInterest(ids[1]);
+  face->receive(*util::makeData("/A/3"));
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_REQUIRE_EQUAL(satisfied.size(), 1);
+  BOOST_CHECK_EQUAL(satisfied[0], Name("/A/3"));
+
+  advanceClocks(time::milliseconds(10), 10);
+  BOOST_CHECK_EQUAL(nTimeouts, 1);
+}
+
+BOOST_AUTO_TEST_CASE(InterestAggregation)
+{
+  face->setInterestAggregation(true);
+
+  size_t nData = 0;
+  size_t nTimeouts = 0;
+  auto onData = [&] (const Interest&, const Data&) { ++nData; };
+  auto onTimeout = [&] (const Interest&) { ++nTimeouts; };
+
+  face->expressInterest(Interest("/A", time::milliseconds(50)), onData, onTimeout);
+  face->expressInterest(Interest("/A", time::milliseconds(100)), onData, onTimeout);
+  face->expressInterest(Interest("/A", time::milliseconds(50)).setMustBeFresh(true),
+                        onData, onTimeout);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(face->getMetrics().nAggregatedInterests, 1);
+
+  // the aggregated Interest is sent when the first one times out
+  advanceClocks(time::milliseconds(10), 5);
+  BOOST_CHECK_EQUAL(nTimeouts, 2);
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 3);
+
+  face->receive(*util::makeData("/A/1"));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(nData, 1);
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 0);
+
+  face->expressInterest(Interest("/B", time::milliseconds(50)), onData, onTimeout);
+  face->expressInterest(Interest("/B", time::milliseconds(50)), onData, onTimeout);
+  advanceClocks(time::milliseconds(10));
+  face->receive(*util::makeData("/B/1"));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(nData, 3);
+  BOOST_CHECK_EQUAL(face->sentInterests.size(), 4);
+}
+
 BOOST_AUTO_TEST_CASE(RemovePendingInterest)
 {
   const PendingInterestId* interestId =
@@ -145,6 +372,36 @@ BOOST_AUTO_TEST_CASE(RemovePendingInterest)
   advanceClocks(time::milliseconds(10), 100);
 }
 
+BOOST_AUTO_TEST_CASE(RemoveAllPendingInterests)
+{
+  auto onData = bind([] { BOOST_FAIL("Unexpected data"); });
+  auto onTimeout = bind([] { BOOST_FAIL("Unexpected timeout"); });
+
+  face->expressInterest(Interest("/A/1", time::milliseconds(50)), onData, onTimeout);
+  const PendingInterestId* interestId =
+    face->expressInterest(Interest("/A/2", time::milliseconds(50)), onData, onTimeout);
+  face->expressInterest(Interest("/B", time::milliseconds(50)), onData, onTimeout);
+  face->expressInterest(Interest("/C", time::milliseconds(50)), onData, onTimeout);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 4);
+
+  face->removePendingInterest(interestId);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 3);
+
+  face->removeAllPendingInterests("/A");
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 2);
+
+  face->removeAllPendingInterests();
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face->getNPendingInterests(), 0);
+
+  face->receive(*util::makeData("/A/1"));
+  face->receive(*util::makeData("/B"));
+  advanceClocks(time::milliseconds(10), 100);
+}
+
 BOOST_AUTO_TEST_CASE(SetUnsetInterestFilter)
 {
   size_t nInterests = 0;
@@ -500,6 +757,149 @@ BOOST_AUTO_TEST_CASE(PutDataWithLocalControlHeader)
   BOOST_CHECK(!face->sentDatas[0].getLocalControlHeader().hasIncomingFaceId());
 }
 
+BOOST_AUTO_TEST_CASE(PutDataBatch)
+{
+  std::vector<Data> batch{*util::makeData("/A/1"), *util::makeData("/A/2")};
+  face->put(batch);
+  BOOST_CHECK_EQUAL(face->sentDatas.size(), 0);
+
+  advanceClocks(time::milliseconds(10));
+  BOOST_REQUIRE_EQUAL(face->sentDatas.size(), 2);
+  BOOST_CHECK_EQUAL(face->sentDatas[0].getName(), Name("/A/1"));
+  BOOST_CHECK_EQUAL(face->sentDatas[1].getName(), Name("/A/2"));
+}
+
+BOOST_AUTO_TEST_CASE(SendWatermarks)
+{
+  std::vector<bool> transitions;
+  face->onWritable.connect([&] { transitions.push_back(true); });
+  face->onUnwritable.connect([&] { transitions.push_back(false); });
+
+  shared_ptr<Data> data = util::makeData("/A/1");
+  size_t dataSize = data->wireEncode().size();
+  face->setSendWatermarks(dataSize, 2 * dataSize);
+
+  face->put(*data);
+  face->put(*data);
+  BOOST_CHECK(face->isWritable());
+  face->put(*data);
+  BOOST_CHECK(!face->isWritable());
+
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face->sentDatas.size(), 3);
+  BOOST_CHECK(face->isWritable());
+  BOOST_REQUIRE_EQUAL(transitions.size(), 2);
+  BOOST_CHECK_EQUAL(transitions[0], false);
+  BOOST_CHECK_EQUAL(transitions[1], true);
+
+  BOOST_CHECK_THROW(face->setSendWatermarks(2, 1), Face::Error);
+}
+
+BOOST_AUTO_TEST_CASE(SubmitDataFromThreads)
+{
+  const size_t N_THREADS = 4;
+  const size_t N_DATA_PER_THREAD = 100;
+
+  std::vector<std::thread> producers;
+  for (size_t i = 0; i < N_THREADS; ++i) {
+    producers.emplace_back([this, i, N_DATA_PER_THREAD] {
+        for (size_t j = 0; j < N_DATA_PER_THREAD; ++j) {
+          face->submitData(*util::makeData(Name("/A").appendNumber(i).appendNumber(j)));
+        }
+      });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  BOOST_CHECK_EQUAL(face->sentDatas.size(), 0);
+
+  BOOST_CHECK_EQUAL(face->processSubmissions(10), 10);
+  BOOST_CHECK_EQUAL(face->processSubmissions(), N_THREADS * N_DATA_PER_THREAD - 10);
+  BOOST_CHECK_EQUAL(face->processSubmissions(), 0);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face->sentDatas.size(), N_THREADS * N_DATA_PER_THREAD);
+}
+
+BOOST_AUTO_TEST_CASE(SubmissionPollingBatches)
+{
+  for (uint64_t i = 0; i < 5; ++i) {
+    face->submitData(*util::makeData(Name("/A").appendNumber(i)));
+  }
+
+  face->setSubmissionPolling(time::milliseconds(10), 2);
+  advanceClocks(time::milliseconds(1), 15);
+  BOOST_CHECK_EQUAL(face->sentDatas.size(), 2);
+
+  face->setSubmissionPolling(time::nanoseconds::zero());
+  advanceClocks(time::milliseconds(10), 10);
+  BOOST_CHECK_EQUAL(face->sentDatas.size(), 2);
+
+  BOOST_CHECK_EQUAL(face->processSubmissions(), 3);
+  advanceClocks(time::milliseconds(10));
+  BOOST_REQUIRE_EQUAL(face->sentDatas.size(), 5);
+  for (uint64_t i = 0; i < 5; ++i) {
+    BOOST_CHECK_EQUAL(face->sentDatas[i].getName(), Name("/A").appendNumber(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SubmissionPollingStopsWhenDrained)
+{
+  face->setSubmissionPolling(time::milliseconds(1));
+
+  std::thread producer([this] {
+      for (uint64_t i = 0; i < 5; ++i) {
+        face->submitData(*util::makeData(Name("/A").appendNumber(i)));
+      }
+    });
+  producer.join();
+
+  // the poll stops once the queue is drained, so the simulation runs out of events
+  ns3::Simulator::Run();
+  BOOST_CHECK_EQUAL(face->sentDatas.size(), 5);
+
+  // the next submission starts it again
+  std::thread([this] { face->submitData(*util::makeData("/B")); }).join();
+  ns3::Simulator::Run();
+  BOOST_REQUIRE_EQUAL(face->sentDatas.size(), 6);
+  BOOST_CHECK_EQUAL(face->sentDatas[5].getName(), Name("/B"));
+
+  face->setSubmissionPolling(time::nanoseconds::zero());
+}
+
+BOOST_AUTO_TEST_CASE(SubmitInterestWithExecutor)
+{
+  std::vector<function<void()>> postedTasks;
+  size_t nData = 0;
+  size_t nTimeouts = 0;
+  Face::Executor executor = [&] (const function<void()>& task) { postedTasks.push_back(task); };
+
+  std::thread producer([&] {
+      face->submitInterest(Interest("/Hello/World", time::milliseconds(50)),
+                           bind([&] { ++nData; }), nullptr, executor);
+      face->submitInterest(Interest("/Bye/World", time::milliseconds(50)),
+                           nullptr, bind([&] { ++nTimeouts; }), executor);
+    });
+  producer.join();
+
+  face->setSubmissionPolling(time::milliseconds(1));
+  advanceClocks(time::milliseconds(10));
+  BOOST_REQUIRE_EQUAL(face->sentInterests.size(), 2);
+
+  face->receive(*util::makeData("/Hello/World/!"));
+  advanceClocks(time::milliseconds(10), 10);
+  face->setSubmissionPolling(time::nanoseconds::zero());
+
+  // callbacks are left to the executor
+  BOOST_CHECK_EQUAL(nData, 0);
+  BOOST_CHECK_EQUAL(nTimeouts, 0);
+  BOOST_REQUIRE_EQUAL(postedTasks.size(), 2);
+  for (const auto& task : postedTasks) {
+    task();
+  }
+  BOOST_CHECK_EQUAL(nData, 1);
+  BOOST_CHECK_EQUAL(nTimeouts, 1);
+}
+
 BOOST_AUTO_TEST_CASE(ReceiveDataWithLocalControlHeader)
 {
   face->expressInterest(Interest("/Hello/World", time::milliseconds(50)),
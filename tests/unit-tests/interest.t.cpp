@@ -720,6 +720,47 @@ BOOST_AUTO_TEST_CASE(SelectedDelegationChecks)
   BOOST_CHECK_EQUAL(a.hasSelectedDelegation(), false);
 }
 
+BOOST_AUTO_TEST_CASE(SelectedDelegationInPlace)
+{
+  Link link("test", {{10, "/test1"}, {20, "/test2"}, {100, "/test3"}});
+  KeyChain keyChain;
+  keyChain.sign(link);
+
+  Interest a("/A");
+  a.setNonce(1);
+  a.setLink(link.wireEncode());
+  a.setSelectedDelegation(Name("test1"));
+  const uint8_t* wireBefore = a.wireEncode().wire();
+
+  a.setSelectedDelegation(Name("test3"));
+  BOOST_CHECK_EQUAL(a.getSelectedDelegation(), Name("test3"));
+  // the existing wire encoding is updated rather than re-encoded
+  BOOST_CHECK_EQUAL(a.wireEncode().wire(), wireBefore);
+
+  // a wire encoding held elsewhere (e.g. queued for sending) is left intact
+  Block sent = a.wireEncode();
+  a.setSelectedDelegation(Name("test2"));
+  BOOST_CHECK_EQUAL(a.getSelectedDelegation(), Name("test2"));
+  BOOST_CHECK_NE(a.wireEncode().wire(), wireBefore);
+  BOOST_CHECK_EQUAL(Interest(sent).getSelectedDelegation(), Name("test3"));
+  BOOST_CHECK_EQUAL(Interest(a.wireEncode()).getSelectedDelegation(), Name("test2"));
+  a.setSelectedDelegation(Name("test3"));
+
+  Interest b(a.wireEncode());
+  BOOST_CHECK_EQUAL(b.getSelectedDelegation(), Name("test3"));
+
+  // a copy sharing the wire encoding keeps its own selection
+  Interest c(b);
+  c.setSelectedDelegation(size_t(1));
+  BOOST_CHECK_EQUAL(c.getSelectedDelegation(), Name("test2"));
+  BOOST_CHECK_EQUAL(b.getSelectedDelegation(), Name("test3"));
+  BOOST_CHECK_EQUAL(Interest(b.wireEncode()).getSelectedDelegation(), Name("test3"));
+  BOOST_CHECK_EQUAL(Interest(c.wireEncode()).getSelectedDelegation(), Name("test2"));
+
+  BOOST_CHECK_THROW(c.setSelectedDelegation(size_t(3)), Interest::Error);
+  BOOST_CHECK_THROW(c.setSelectedDelegation(Name("test4")), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(EncodeDecodeWithLink)
 {
   Link link1("test", {{10, "/test1"}, {20, "/test2"}, {100, "/test3"}});
@@ -887,6 +928,112 @@ BOOST_AUTO_TEST_CASE(Decode)
   BOOST_CHECK_EQUAL(i.getNonce(), 1U);
 }
 
+BOOST_AUTO_TEST_CASE(DecodeThenModify)
+{
+  Block interestBlock(Interest1, sizeof(Interest1));
+
+  // Selectors are decoded lazily, modifying the Name must not lose them
+  ndn::Interest i(interestBlock);
+  i.setName("/another/prefix");
+  BOOST_CHECK_EQUAL(i.hasWire(), false);
+
+  BOOST_CHECK_EQUAL(i.getName().toUri(), "/another/prefix");
+  BOOST_CHECK_EQUAL(i.getMinSuffixComponents(), 1);
+  BOOST_CHECK_EQUAL(i.getMaxSuffixComponents(), 1);
+  BOOST_CHECK_EQUAL(i.getChildSelector(), 1);
+  BOOST_CHECK_EQUAL(i.getExclude().toUri(), "alex,xxxx,*,yyyy");
+  BOOST_CHECK_EQUAL(i.getNonce(), 1U);
+
+  ndn::Interest j(i.wireEncode());
+  BOOST_CHECK_EQUAL(i, j);
+  BOOST_CHECK_EQUAL(j.getExclude().toUri(), "alex,xxxx,*,yyyy");
+
+  // re-decoding into the same object replaces previously decoded fields
+  j.wireDecode(ndn::Interest("/no/selectors").wireEncode());
+  BOOST_CHECK_EQUAL(j.hasSelectors(), false);
+  BOOST_CHECK_EQUAL(j.getMinSuffixComponents(), -1);
+}
+
+BOOST_AUTO_TEST_CASE(DecodeMalformedSelectors)
+{
+  // Selectors are decoded on first access, but malformed ones are rejected by wireDecode
+  const uint8_t badMinSuffixComponents[] = {
+    0x05, 0x12,
+      0x07, 0x03, 0x08, 0x01, 0x61,
+      0x09, 0x05,
+        0x0d, 0x03, 0x00, 0x00, 0x01, // 3-octet NonNegativeInteger
+      0x0a, 0x04, 0x01, 0x02, 0x03, 0x04
+  };
+  BOOST_CHECK_THROW(ndn::Interest(Block(badMinSuffixComponents,
+                                        sizeof(badMinSuffixComponents))),
+                    tlv::Error);
+
+  const uint8_t badExclude[] = {
+    0x05, 0x13,
+      0x07, 0x03, 0x08, 0x01, 0x61,
+      0x09, 0x06,
+        0x10, 0x04, 0x13, 0x00, 0x13, 0x00, // Any following Any
+      0x0a, 0x04, 0x01, 0x02, 0x03, 0x04
+  };
+  BOOST_CHECK_THROW(ndn::Interest(Block(badExclude, sizeof(badExclude))), tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(CopyOnWrite)
+{
+  Block interestBlock(Interest1, sizeof(Interest1));
+
+  ndn::Interest a(interestBlock);
+  ndn::Interest b(a);
+  BOOST_CHECK_EQUAL(a.wireEncode().wire(), b.wireEncode().wire());
+  // selectors were decoded before the core was shared, so reading them writes nothing
+  BOOST_CHECK_EQUAL(&a.getSelectors(), &b.getSelectors());
+
+  // modifying a copy does not affect the original, even when Nonce is updated in place
+  b.setNonce(42);
+  BOOST_CHECK_EQUAL(a.getNonce(), 1U);
+  BOOST_CHECK_EQUAL(b.getNonce(), 42U);
+  BOOST_CHECK(a.wireEncode() == interestBlock);
+
+  ndn::Interest c(a);
+  c.setName("/another/prefix");
+  BOOST_CHECK_EQUAL(a.getName(), Name("/local/ndn/prefix"));
+  BOOST_CHECK_EQUAL(c.getExclude().toUri(), "alex,xxxx,*,yyyy");
+
+  // an Interest without wire encoding is not shared, so encoding a copy leaves it unchanged
+  ndn::Interest d("/d");
+  d.setNonce(1);
+  ndn::Interest e(d);
+  e.wireEncode();
+  BOOST_CHECK_EQUAL(d.hasWire(), false);
+
+  d.setNonce(7);
+  BOOST_CHECK_EQUAL(d.getNonce(), 7U);
+  BOOST_CHECK_EQUAL(e.getNonce(), 1U);
+}
+
+BOOST_AUTO_TEST_CASE(Clone)
+{
+  Block interestBlock(Interest1, sizeof(Interest1));
+
+  ndn::Interest a(interestBlock);
+  ndn::Interest copy(a);
+  ndn::Interest clone = a.clone();
+
+  // a copy shares the cached encoding, a clone has its own that refers to the same bytes
+  BOOST_CHECK_EQUAL(&copy.wireEncode(), &a.wireEncode());
+  BOOST_CHECK_NE(&clone.wireEncode(), &a.wireEncode());
+  BOOST_CHECK_EQUAL(clone.wireEncode().wire(), a.wireEncode().wire());
+  BOOST_CHECK_EQUAL(clone, a);
+  BOOST_CHECK_EQUAL(clone.getExclude().toUri(), "alex,xxxx,*,yyyy");
+
+  // the encoding cached later by one of them is not seen by the other
+  ndn::Interest b("/b");
+  b.setNonce(1);
+  ndn::Interest bClone = b.clone();
+  b.wireEncode();
+  BOOST_CHECK_EQUAL(bClone.hasWire(), false);
+}
+
 BOOST_AUTO_TEST_CASE(DecodeFromStream)
 {
   boost::iostreams::stream<boost::iostreams::array_source> is(
@@ -183,6 +183,55 @@ BOOST_AUTO_TEST_CASE(AppMetaInfo)
   }
 }
 
+BOOST_AUTO_TEST_CASE(DecodeReplacesAppMetaInfo)
+{
+  MetaInfo info1;
+  info1.addAppMetaInfo(makeNonNegativeIntegerBlock(128, 1));
+  info1.addAppMetaInfo(makeNonNegativeIntegerBlock(129, 2));
+
+  MetaInfo info2;
+  info2.addAppMetaInfo(makeNonNegativeIntegerBlock(130, 3));
+  info2.wireDecode(info1.wireEncode());
+  BOOST_CHECK_EQUAL(info2.getAppMetaInfo().size(), 2);
+  BOOST_CHECK(info2.findAppMetaInfo(130) == nullptr);
+
+  info2.wireDecode(MetaInfo().wireEncode());
+  BOOST_CHECK_EQUAL(info2.getAppMetaInfo().size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SetAppMetaInfo)
+{
+  MetaInfo info;
+  info.setAppMetaInfo({makeNonNegativeIntegerBlock(128, 1), makeNonNegativeIntegerBlock(129, 2)});
+  const std::list<Block>& appMetaInfo = info.getAppMetaInfo();
+  BOOST_CHECK_EQUAL(appMetaInfo.size(), 2);
+
+  std::list<Block> items{makeNonNegativeIntegerBlock(130, 3)};
+  info.setAppMetaInfo(items);
+  BOOST_REQUIRE_EQUAL(info.getAppMetaInfo().size(), 1);
+  BOOST_CHECK_EQUAL(info.getAppMetaInfo().front().type(), 130);
+
+  items.push_back(makeNonNegativeIntegerBlock(253, 4));
+  BOOST_CHECK_THROW(info.setAppMetaInfo(items), MetaInfo::Error);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeDecodedWire)
+{
+  // FreshnessPeriod is not minimally encoded
+  const uint8_t METAINFO[] = {0x14, 0x06, 0x19, 0x04, 0x00, 0x00, 0x03, 0xe8};
+  MetaInfo info(Block(METAINFO, sizeof(METAINFO)));
+  BOOST_CHECK_EQUAL(info.getFreshnessPeriod(), time::milliseconds(1000));
+
+  // the decoded bytes are reused rather than re-encoded
+  EncodingBuffer encoder;
+  info.wireEncode(encoder);
+  BOOST_CHECK_EQUAL_COLLECTIONS(encoder.begin(), encoder.end(),
+                                METAINFO, METAINFO + sizeof(METAINFO));
+
+  info.setFreshnessPeriod(time::milliseconds(1000));
+  BOOST_CHECK_EQUAL(info.wireEncode().size(), 6);
+}
+
 BOOST_AUTO_TEST_CASE(AppMetaInfoTypeRange)
 {
   MetaInfo info;
@@ -20,6 +20,7 @@
  */
 
 #include "signature-info.hpp"
+#include "encoding/block-helpers.hpp"
 
 #include "boost-test.hpp"
 
@@ -224,6 +225,32 @@ BOOST_AUTO_TEST_CASE(OtherTlvs)
   BOOST_REQUIRE_NO_THROW(info.getTypeSpecificTlv(0x81));
 }
 
+BOOST_AUTO_TEST_CASE(OtherTlvsEncoding)
+{
+  SignatureInfo info(tlv::DigestSha256);
+  info.appendTypeSpecificTlv(makeNonNegativeIntegerBlock(0x81, 1));
+  const Block& wire1 = info.wireEncode();
+  BOOST_CHECK_EQUAL(wire1.size(), 8);
+
+  // appending invalidates the cached encoding, and TLVs are kept in order
+  info.appendTypeSpecificTlv(makeNonNegativeIntegerBlock(0x82, 2));
+  const uint8_t expected[] = {
+    0x16, 0x09,
+      0x1b, 0x01, 0x00,
+      0x81, 0x01, 0x01,
+      0x82, 0x01, 0x02,
+  };
+  const Block& wire2 = info.wireEncode();
+  BOOST_CHECK_EQUAL_COLLECTIONS(wire2.begin(), wire2.end(), expected, expected + sizeof(expected));
+
+  SignatureInfo decoded(tlv::SignatureSha256WithRsa);
+  decoded.appendTypeSpecificTlv(makeNonNegativeIntegerBlock(0x83, 3));
+  decoded.wireDecode(Block(expected, sizeof(expected)));
+  BOOST_CHECK_EQUAL(decoded.getSignatureType(), tlv::DigestSha256);
+  BOOST_CHECK_THROW(decoded.getTypeSpecificTlv(0x83), SignatureInfo::Error);
+  BOOST_CHECK(decoded == info);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -52,6 +52,21 @@ public:
   }
 };
 
+struct HopCountTag
+{
+  typedef uint64_t ValueType;
+};
+
+struct IncomingFaceIdTag
+{
+  typedef uint64_t ValueType;
+};
+
+struct SmallTag
+{
+  typedef uint32_t ValueType;
+};
+
 typedef boost::mpl::vector<TagHost, Interest, Data> Fixtures;
 
 BOOST_FIXTURE_TEST_CASE_TEMPLATE(Basic, T, Fixtures, T)
@@ -80,6 +95,55 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(Basic, T, Fixtures, T)
   BOOST_CHECK(this->template getTag<TestTag2>() == nullptr);
 }
 
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(InlineValue, T, Fixtures, T)
+{
+  BOOST_CHECK(this->template getTagValue<HopCountTag>() == nullptr);
+
+  this->template setTagValue<HopCountTag>(42);
+  BOOST_REQUIRE(this->template getTagValue<HopCountTag>() != nullptr);
+  BOOST_CHECK_EQUAL(*this->template getTagValue<HopCountTag>(), 42);
+  BOOST_CHECK(this->template getTagValue<SmallTag>() == nullptr);
+
+  this->setTag(make_shared<TestTag>());
+  this->template setTagValue<HopCountTag>(43);
+  BOOST_CHECK_EQUAL(*this->template getTagValue<HopCountTag>(), 43);
+  BOOST_CHECK(this->template getTag<TestTag>() != nullptr);
+
+  this->template removeTagValue<HopCountTag>();
+  BOOST_CHECK(this->template getTagValue<HopCountTag>() == nullptr);
+  BOOST_CHECK(this->template getTag<TestTag>() != nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE_TEMPLATE(InlineValuesOfSameType, T, Fixtures, T)
+{
+  // tags with the same value type do not overwrite each other
+  this->template setTagValue<HopCountTag>(3);
+  this->template setTagValue<IncomingFaceIdTag>(256);
+  BOOST_CHECK_EQUAL(*this->template getTagValue<HopCountTag>(), 3);
+  BOOST_CHECK_EQUAL(*this->template getTagValue<IncomingFaceIdTag>(), 256);
+
+  this->template removeTagValue<HopCountTag>();
+  BOOST_CHECK(this->template getTagValue<HopCountTag>() == nullptr);
+  BOOST_CHECK_EQUAL(*this->template getTagValue<IncomingFaceIdTag>(), 256);
+}
+
+BOOST_AUTO_TEST_CASE(Copy)
+{
+  TagHost host;
+  auto tag = make_shared<TestTag>();
+  host.setTag(tag);
+  host.setTagValue<SmallTag>(7);
+
+  TagHost copy(host);
+  BOOST_CHECK_EQUAL(copy.getTag<TestTag>(), tag);
+  BOOST_CHECK_EQUAL(*copy.getTagValue<SmallTag>(), 7);
+
+  copy.removeTag<TestTag>();
+  copy.setTagValue<SmallTag>(8);
+  BOOST_CHECK_EQUAL(host.getTag<TestTag>(), tag);
+  BOOST_CHECK_EQUAL(*host.getTagValue<SmallTag>(), 7);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "transport/send-queue-monitor.hpp"
+
+#include "boost-test.hpp"
+#include "../unit-test-time-fixture.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(TransportSendQueueMonitor, UnitTestTimeFixture)
+
+BOOST_AUTO_TEST_CASE(Depth)
+{
+  SendQueueMonitor monitor;
+  monitor.enqueue(100);
+  monitor.enqueue(300, 2);
+  monitor.dequeue(100);
+
+  SendQueueStatistics statistics = monitor.getStatistics();
+  BOOST_CHECK_EQUAL(statistics.nQueuedBytes, 300);
+  BOOST_CHECK_EQUAL(statistics.nQueuedPackets, 2);
+  BOOST_CHECK_EQUAL(statistics.maxQueuedBytes, 400);
+  BOOST_CHECK_EQUAL(statistics.maxQueuedPackets, 3);
+
+  monitor.resetStatistics();
+  statistics = monitor.getStatistics();
+  BOOST_CHECK_EQUAL(statistics.nQueuedBytes, 300);
+  BOOST_CHECK_EQUAL(statistics.maxQueuedBytes, 300);
+  BOOST_CHECK_EQUAL(statistics.maxQueuedPackets, 2);
+
+  monitor.clear();
+  BOOST_CHECK_EQUAL(monitor.getStatistics().nQueuedBytes, 0);
+  BOOST_CHECK_EQUAL(monitor.getStatistics().nQueuedPackets, 0);
+
+  // without watermarks, the queue is always writable
+  monitor.enqueue(1000000);
+  BOOST_CHECK(monitor.isWritable());
+  BOOST_CHECK_EQUAL(monitor.getStatistics().nUnwritable, 0);
+}
+
+BOOST_AUTO_TEST_CASE(Watermarks)
+{
+  SendQueueMonitor monitor;
+  std::vector<bool> transitions;
+  monitor.setWritabilityCallback([&] (bool isWritable) { transitions.push_back(isWritable); });
+  monitor.setWatermarks(100, 200);
+
+  monitor.enqueue(200);
+  BOOST_CHECK(monitor.isWritable());
+  monitor.enqueue(1);
+  BOOST_CHECK(!monitor.isWritable());
+  BOOST_REQUIRE_EQUAL(transitions.size(), 1);
+  BOOST_CHECK_EQUAL(transitions.back(), false);
+
+  advanceClocks(time::milliseconds(10));
+
+  // hysteresis: the queue stays unwritable until it drops to the low watermark
+  monitor.dequeue(100);
+  BOOST_CHECK(!monitor.isWritable());
+  monitor.dequeue(1);
+  BOOST_CHECK(monitor.isWritable());
+  BOOST_REQUIRE_EQUAL(transitions.size(), 2);
+  BOOST_CHECK_EQUAL(transitions.back(), true);
+
+  SendQueueStatistics statistics = monitor.getStatistics();
+  BOOST_CHECK_EQUAL(statistics.nUnwritable, 1);
+  BOOST_CHECK(statistics.unwritableTime == time::milliseconds(10));
+
+  // the ongoing unwritable period is included
+  monitor.enqueue(200);
+  advanceClocks(time::milliseconds(5));
+  statistics = monitor.getStatistics();
+  BOOST_CHECK_EQUAL(statistics.nUnwritable, 2);
+  BOOST_CHECK(statistics.unwritableTime == time::milliseconds(15));
+
+  // disabling the watermarks makes the queue writable
+  monitor.setWatermarks(0, 0);
+  BOOST_CHECK(monitor.isWritable());
+  BOOST_CHECK_EQUAL(transitions.size(), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace ndn
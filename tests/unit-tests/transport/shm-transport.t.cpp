@@ -0,0 +1,463 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "transport/shm-transport.hpp"
+#include "transport-fixture.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+#if defined(NDN_CXX_HAVE_EVENTFD)
+#include "transport/shm-ring.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif // defined(NDN_CXX_HAVE_EVENTFD)
+
+namespace ndn {
+namespace tests {
+
+BOOST_FIXTURE_TEST_SUITE(TransportShmTransport, TransportFixture)
+
+BOOST_AUTO_TEST_CASE(GetDefaultSocketNameOk)
+{
+  initializeConfig("tests/unit-tests/transport/test-homes/shm-transport/ok");
+
+  BOOST_CHECK_EQUAL(ShmTransport::getDefaultSocketName(*m_config), "/tmp/test/nfd-shm.sock");
+}
+
+BOOST_AUTO_TEST_CASE(GetDefaultSocketNameOkOmittedSocket)
+{
+  initializeConfig("tests/unit-tests/transport/test-homes/shm-transport/ok-omitted-socket");
+
+  BOOST_CHECK_EQUAL(ShmTransport::getDefaultSocketName(*m_config), "/var/run/nfd-shm.sock");
+}
+
+BOOST_AUTO_TEST_CASE(GetDefaultSocketNameBadWrongTransport)
+{
+  initializeConfig("tests/unit-tests/transport/test-homes/shm-transport/bad-wrong-transport");
+
+  BOOST_CHECK_EXCEPTION(ShmTransport::getDefaultSocketName(*m_config),
+                        Transport::Error,
+                        [] (const Transport::Error& error) {
+                          return error.what() == std::string("Cannot create ShmTransport "
+                                                             "from \"unix\" URI");
+                        });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#if defined(NDN_CXX_HAVE_EVENTFD)
+
+/** \brief stand-in for a forwarder that offers shared memory sessions
+ */
+class ShmForwarderFixture
+{
+protected:
+  ShmForwarderFixture()
+    : socketPath((boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path()).string())
+    , acceptor(io, socketPath)
+    , peer(io)
+    , isAccepted(false)
+    , transport(socketPath)
+  {
+  }
+
+  ~ShmForwarderFixture()
+  {
+    transport.close();
+    if (memory != nullptr)
+      ::munmap(memory, 2 * ShmRing::getMemorySize(capacity));
+    if (appEventFd >= 0)
+      ::close(appEventFd);
+    if (eventFd >= 0)
+      ::close(eventFd);
+    boost::filesystem::remove(socketPath);
+  }
+
+  /** \brief accept the session of the transport and hand it rings of \p ringCapacity bytes
+   *  \param memorySize size of the shared memory, if not the size of the two rings
+   */
+  void
+  acceptSession(size_t ringCapacity, size_t memorySize = 0)
+  {
+    capacity = ringCapacity;
+    acceptor.async_accept(peer, [this] (const boost::system::error_code& error) {
+      BOOST_REQUIRE(!error);
+      isAccepted = true;
+    });
+
+    transport.connect(io, [this] (const std::vector<Block>& wires) {
+      batches.push_back(wires);
+    });
+    while (!isAccepted) {
+      io.run_one();
+    }
+
+    // shared memory backed by an unlinked file
+    char memoryPath[] = "/tmp/ndn-cxx-shm-XXXXXX";
+    int memoryFd = ::mkstemp(memoryPath);
+    BOOST_REQUIRE(memoryFd >= 0);
+    ::unlink(memoryPath);
+    size_t ringSize = ShmRing::getMemorySize(capacity);
+    BOOST_REQUIRE_EQUAL(::ftruncate(memoryFd, memorySize > 0 ? memorySize : 2 * ringSize), 0);
+    if (memorySize == 0) {
+      memory = static_cast<uint8_t*>(::mmap(nullptr, 2 * ringSize, PROT_READ | PROT_WRITE,
+                                            MAP_SHARED, memoryFd, 0));
+      BOOST_REQUIRE(memory != MAP_FAILED);
+      toForwarder.reset(new ShmRing(memory, capacity));
+      toApp.reset(new ShmRing(memory + ringSize, capacity));
+      toForwarder->reset();
+      toApp->reset();
+    }
+
+    appEventFd = ::eventfd(0, EFD_NONBLOCK);
+    eventFd = ::eventfd(0, EFD_NONBLOCK);
+
+    uint64_t capacity64 = capacity;
+    iovec iov;
+    iov.iov_base = &capacity64;
+    iov.iov_len = sizeof(capacity64);
+    union {
+      cmsghdr header;
+      uint8_t buffer[CMSG_SPACE(3 * sizeof(int))];
+    } control;
+    msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(3 * sizeof(int));
+    int fds[] = {memoryFd, appEventFd, eventFd};
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+    BOOST_REQUIRE_EQUAL(::sendmsg(peer.native_handle(), &message, 0), sizeof(capacity64));
+    ::close(memoryFd);
+
+    while (!transport.isConnected()) {
+      io.run_one();
+    }
+  }
+
+  /** \return number of times the transport signalled the forwarder since the last call
+   */
+  uint64_t
+  readEvent()
+  {
+    uint64_t counter = 0;
+    ssize_t nBytesRead = ::read(eventFd, &counter, sizeof(counter));
+    return nBytesRead == sizeof(counter) ? counter : 0;
+  }
+
+  void
+  signalApp()
+  {
+    uint64_t increment = 1;
+    BOOST_REQUIRE_EQUAL(::write(appEventFd, &increment, sizeof(increment)), sizeof(increment));
+  }
+
+protected:
+  boost::asio::io_service io;
+  std::string socketPath;
+  boost::asio::local::stream_protocol::acceptor acceptor;
+  boost::asio::local::stream_protocol::socket peer;
+  bool isAccepted;
+  ShmTransport transport;
+  std::vector<std::vector<Block>> batches;
+
+  size_t capacity = 0;
+  uint8_t* memory = nullptr;
+  unique_ptr<ShmRing> toForwarder;
+  unique_ptr<ShmRing> toApp;
+  int appEventFd = -1; ///< signalled by the stand-in
+  int eventFd = -1; ///< signalled by the transport
+};
+
+BOOST_FIXTURE_TEST_SUITE(TransportShmTransportSession, ShmForwarderFixture)
+
+BOOST_AUTO_TEST_CASE(SendReceive)
+{
+  acceptSession(4096);
+
+  // header and payload that together form one element, like LocalControlHeader does
+  Block payload = makeNonNegativeIntegerBlock(tlv::Content, 3);
+  Block element(tlv::Name, payload);
+  element.encode();
+  Block header(element, element.begin(), element.value_begin(), false);
+
+  transport.send(makeNonNegativeIntegerBlock(tlv::Content, 1));
+  transport.send(makeNonNegativeIntegerBlock(tlv::Content, 2));
+  transport.send(header, payload);
+  io.poll();
+  BOOST_CHECK_EQUAL(readEvent(), 1); // one wake-up for the burst
+
+  std::vector<Block> received;
+  BOOST_REQUIRE_EQUAL(toForwarder->read(received), 3);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(received[0]), 1);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(received[1]), 2);
+  BOOST_CHECK(received[2] == element);
+  BOOST_CHECK(toForwarder->isEmpty());
+
+  BOOST_REQUIRE(toApp->write(makeNonNegativeIntegerBlock(tlv::Content, 4)));
+  BOOST_REQUIRE(toApp->write(makeNonNegativeIntegerBlock(tlv::Content, 5)));
+  signalApp();
+  while (batches.empty()) {
+    io.run_one();
+  }
+  BOOST_REQUIRE_EQUAL(batches.size(), 1);
+  BOOST_REQUIRE_EQUAL(batches[0].size(), 2);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(batches[0][0]), 4);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(batches[0][1]), 5);
+}
+
+BOOST_AUTO_TEST_CASE(FullRing)
+{
+  acceptSession(1024);
+
+  std::vector<uint8_t> payload(200, 0xBB);
+  for (uint64_t i = 0; i < 20; ++i) {
+    transport.send(makeBinaryBlock(tlv::Content, payload.data(), payload.size()));
+  }
+  io.poll();
+  BOOST_CHECK_EQUAL(readEvent(), 1);
+  BOOST_CHECK(toForwarder->isProducerWaiting());
+
+  std::vector<Block> received;
+  while (true) {
+    BOOST_REQUIRE_GT(toForwarder->read(received), 0);
+    if (toForwarder->isProducerWaiting()) {
+      toForwarder->setProducerWaiting(false);
+      signalApp();
+    }
+    if (received.size() >= 20)
+      break;
+
+    // wait until the transport writes the blocks queued while the ring was full
+    while (readEvent() == 0) {
+      io.run_one();
+    }
+  }
+  BOOST_CHECK_EQUAL(received.size(), 20);
+  BOOST_CHECK_EQUAL(received.back().value_size(), payload.size());
+}
+
+BOOST_AUTO_TEST_CASE(PausedFullRing)
+{
+  acceptSession(1024);
+  transport.pause();
+
+  // space freed by the forwarder is still noticed while paused
+  std::vector<uint8_t> payload(200, 0xBB);
+  for (uint64_t i = 0; i < 20; ++i) {
+    transport.send(makeBinaryBlock(tlv::Content, payload.data(), payload.size()));
+  }
+  io.poll();
+  BOOST_CHECK_EQUAL(readEvent(), 1);
+
+  BOOST_REQUIRE(toApp->write(makeNonNegativeIntegerBlock(tlv::Content, 1)));
+
+  std::vector<Block> received;
+  while (true) {
+    BOOST_REQUIRE_GT(toForwarder->read(received), 0);
+    if (toForwarder->isProducerWaiting()) {
+      toForwarder->setProducerWaiting(false);
+      signalApp();
+    }
+    if (received.size() >= 20)
+      break;
+
+    while (readEvent() == 0) {
+      io.run_one();
+    }
+  }
+  BOOST_CHECK_EQUAL(received.size(), 20);
+
+  // nothing is delivered while paused
+  io.poll();
+  BOOST_CHECK(batches.empty());
+
+  transport.resume();
+  io.poll();
+  BOOST_REQUIRE_EQUAL(batches.size(), 1);
+  BOOST_REQUIRE_EQUAL(batches[0].size(), 1);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(batches[0][0]), 1);
+}
+
+BOOST_AUTO_TEST_CASE(SharedMemoryTooSmall)
+{
+  BOOST_CHECK_THROW(acceptSession(4096, 4096), Transport::Error);
+  BOOST_CHECK(!transport.isConnected());
+}
+
+BOOST_AUTO_TEST_CASE(PeerClosed)
+{
+  acceptSession(4096);
+
+  peer.close();
+  BOOST_CHECK_THROW(io.run(), Transport::Error);
+  BOOST_CHECK(!transport.isConnected());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/** \brief counting wake-up between two threads, standing in for the eventfd of a session
+ */
+class WakeUp
+{
+public:
+  void
+  signal()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_count;
+    m_cv.notify_one();
+  }
+
+  /** \return false if no signal arrives within a few seconds
+   */
+  bool
+  wait()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (!m_cv.wait_for(lock, std::chrono::seconds(5), [this] { return m_count > 0; }))
+      return false;
+    m_count = 0;
+    return true;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  size_t m_count = 0;
+};
+
+class ShmRingFixture
+{
+public:
+  ShmRingFixture()
+    : memory(static_cast<uint8_t*>(::mmap(nullptr, ShmRing::getMemorySize(CAPACITY),
+                                          PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS,
+                                          -1, 0)))
+  {
+    BOOST_REQUIRE(memory != MAP_FAILED);
+    ring.reset(new ShmRing(memory, CAPACITY));
+    ring->reset();
+  }
+
+  ~ShmRingFixture()
+  {
+    ::munmap(memory, ShmRing::getMemorySize(CAPACITY));
+  }
+
+public:
+  /// room for only a few records, so that the producer waits often
+  static const size_t CAPACITY = 64;
+
+  uint8_t* memory;
+  unique_ptr<ShmRing> ring;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TransportShmRing, ShmRingFixture)
+
+BOOST_AUTO_TEST_CASE(ProducerWakeUpIsNeverLost)
+{
+  static const uint64_t N_RECORDS = 100000;
+  WakeUp dataAvailable;
+  WakeUp spaceAvailable;
+  bool isProducerStuck = false;
+  bool isConsumerStuck = false;
+
+  // same handshake as ShmTransport: the producer is woken up only by a consumer that
+  // frees space and sees the mark, and the consumer only by the producer writing
+  std::thread producer([&] {
+      for (uint64_t i = 0; i < N_RECORDS; ++i) {
+        Block block = makeNonNegativeIntegerBlock(tlv::Content, i);
+        while (!ring->write(block)) {
+          ring->setProducerWaiting(true);
+          if (ring->write(block))
+            break;
+          if (!spaceAvailable.wait()) {
+            isProducerStuck = true;
+            return;
+          }
+        }
+        dataAvailable.signal();
+      }
+    });
+
+  uint64_t nRead = 0;
+  bool isInOrder = true;
+  std::vector<Block> blocks;
+  while (nRead < N_RECORDS) {
+    if (!dataAvailable.wait()) {
+      isConsumerStuck = true;
+      break;
+    }
+    blocks.clear();
+    ring->read(blocks);
+    for (const Block& block : blocks) {
+      isInOrder = isInOrder && readNonNegativeInteger(block) == nRead;
+      ++nRead;
+    }
+    if (ring->isProducerWaiting()) {
+      ring->setProducerWaiting(false);
+      spaceAvailable.signal();
+    }
+  }
+  producer.join();
+
+  BOOST_CHECK(!isProducerStuck);
+  BOOST_CHECK(!isConsumerStuck);
+  BOOST_CHECK(isInOrder);
+  BOOST_CHECK_EQUAL(nRead, N_RECORDS);
+}
+
+BOOST_AUTO_TEST_CASE(CorruptedLength)
+{
+  BOOST_REQUIRE(ring->write(makeNonNegativeIntegerBlock(tlv::Content, 1)));
+
+  // a length close to the 32-bit maximum must not wrap around in the bounds check
+  uint32_t length = 0xFFFFFFF0;
+  std::memcpy(memory + ShmRing::CONTROL_SIZE, &length, sizeof(length));
+
+  std::vector<Block> blocks;
+  BOOST_CHECK_THROW(ring->read(blocks), ShmRing::Error);
+  BOOST_CHECK(blocks.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif // defined(NDN_CXX_HAVE_EVENTFD)
+
+} // namespace tests
+} // namespace ndn
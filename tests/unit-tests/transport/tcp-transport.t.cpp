@@ -21,6 +21,7 @@
 
 #include "transport/tcp-transport.hpp"
 #include "transport-fixture.hpp"
+#include "encoding/block-helpers.hpp"
 
 #include "boost-test.hpp"
 
@@ -98,6 +99,115 @@ BOOST_AUTO_TEST_CASE(GetDefaultSocketHostAndPortBadMalformedUri)
                         });
 }
 
+BOOST_AUTO_TEST_CASE(GetDefaultOptionsOk)
+{
+  initializeConfig("tests/unit-tests/transport/test-homes/tcp-transport/ok-options");
+
+  const TcpTransport::Options options = TcpTransport::getDefaultOptions(*m_config);
+
+  BOOST_CHECK_EQUAL(options.noDelay, false);
+  BOOST_CHECK_EQUAL(options.cork, true);
+  BOOST_CHECK_EQUAL(options.sendBufferSize, 1048576);
+  BOOST_CHECK_EQUAL(options.receiveBufferSize, 2097152);
+  BOOST_CHECK(options.connectTimeout == time::milliseconds(500));
+  BOOST_CHECK_EQUAL(options.zeroCopyThreshold, 32768);
+  BOOST_CHECK_EQUAL(options.writeBatchSize, 262144);
+}
+
+BOOST_AUTO_TEST_CASE(GetDefaultOptionsOkOmitted)
+{
+  initializeConfig("tests/unit-tests/transport/test-homes/tcp-transport/ok");
+
+  const TcpTransport::Options options = TcpTransport::getDefaultOptions(*m_config);
+
+  BOOST_CHECK_EQUAL(options.noDelay, true);
+  BOOST_CHECK_EQUAL(options.cork, false);
+  BOOST_CHECK_EQUAL(options.sendBufferSize, 0);
+  BOOST_CHECK_EQUAL(options.receiveBufferSize, 0);
+  BOOST_CHECK(options.connectTimeout == time::seconds(4));
+  BOOST_CHECK_EQUAL(options.zeroCopyThreshold, 0);
+  BOOST_CHECK_EQUAL(options.writeBatchSize, 0);
+}
+
+BOOST_AUTO_TEST_CASE(GetDefaultOptionsBadValue)
+{
+  initializeConfig("tests/unit-tests/transport/test-homes/tcp-transport/bad-options");
+
+  BOOST_CHECK_EXCEPTION(TcpTransport::getDefaultOptions(*m_config),
+                        ConfigFile::Error,
+                        [] (const ConfigFile::Error& error) {
+                          return error.what() == std::string("Invalid value \"large\" "
+                                                             "of a tcp_* field");
+                        });
+}
+
+BOOST_AUTO_TEST_CASE(GetDefaultOptionsBadConnectTimeout)
+{
+  initializeConfig("tests/unit-tests/transport/test-homes/tcp-transport/"
+                   "bad-connect-timeout");
+
+  BOOST_CHECK_THROW(TcpTransport::getDefaultOptions(*m_config), ConfigFile::Error);
+}
+
+BOOST_AUTO_TEST_CASE(SendWithOptions)
+{
+  boost::asio::io_service io;
+  boost::asio::ip::tcp::acceptor acceptor(io, boost::asio::ip::tcp::endpoint(
+                                                boost::asio::ip::address_v4::loopback(), 0));
+  boost::asio::ip::tcp::socket forwarder(io);
+  bool isAccepted = false;
+  acceptor.async_accept(forwarder, [&] (const boost::system::error_code& error) {
+    BOOST_REQUIRE(!error);
+    isAccepted = true;
+  });
+
+  TcpTransport::Options options;
+  options.cork = true;
+  options.sendBufferSize = 256 * 1024;
+  options.receiveBufferSize = 256 * 1024;
+  options.connectTimeout = time::milliseconds(500);
+  options.zeroCopyThreshold = 1; // effective only where MSG_ZEROCOPY is supported
+  options.writeBatchSize = 16 * 1024;
+
+  TcpTransport transport("127.0.0.1", std::to_string(acceptor.local_endpoint().port()), options);
+  transport.connect(io, Transport::ReceiveCallback([] (const Block&) {}));
+  while (!isAccepted || !transport.isConnected()) {
+    io.run_one();
+  }
+
+  // a burst that needs many gathered writes
+  const size_t nPackets = 1000;
+  std::vector<uint8_t> expected;
+  for (size_t i = 0; i < nPackets; ++i) {
+    Block packet = makeNonNegativeIntegerBlock(tlv::Content, i);
+    expected.insert(expected.end(), packet.begin(), packet.end());
+    transport.send(packet);
+  }
+
+  std::vector<uint8_t> received(expected.size());
+  size_t nReceived = 0;
+  std::function<void()> readMore = [&] {
+    forwarder.async_read_some(boost::asio::buffer(&received[nReceived],
+                                                  received.size() - nReceived),
+                              [&] (const boost::system::error_code& error, size_t nBytes) {
+                                BOOST_REQUIRE(!error);
+                                nReceived += nBytes;
+                                if (nReceived < received.size()) {
+                                  readMore();
+                                }
+                              });
+  };
+  readMore();
+  while (nReceived < received.size()) {
+    io.run_one();
+  }
+
+  BOOST_CHECK(received == expected);
+  BOOST_CHECK_EQUAL(transport.getSendQueueMonitor().getStatistics().nQueuedBytes, 0);
+
+  transport.close();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
@@ -21,9 +21,12 @@
 
 #include "transport/unix-transport.hpp"
 #include "transport-fixture.hpp"
+#include "encoding/block-helpers.hpp"
 
 #include "boost-test.hpp"
 
+#include <boost/filesystem.hpp>
+
 namespace ndn {
 namespace tests {
 
@@ -77,6 +80,238 @@ BOOST_AUTO_TEST_CASE(GetDefaultSocketNameBadMalformedUri)
                         });
 }
 
+BOOST_AUTO_TEST_CASE(BatchReceive)
+{
+  const std::string socketPath = (boost::filesystem::temp_directory_path() /
+                                  boost::filesystem::unique_path()).string();
+
+  boost::asio::io_service io;
+  boost::asio::local::stream_protocol::acceptor acceptor(io, socketPath);
+  boost::asio::local::stream_protocol::socket forwarder(io);
+  bool isAccepted = false;
+  acceptor.async_accept(forwarder, [&] (const boost::system::error_code& error) {
+    BOOST_REQUIRE(!error);
+    isAccepted = true;
+  });
+
+  std::vector<std::vector<Block>> batches;
+  UnixTransport transport(socketPath);
+  transport.connect(io, [&] (const std::vector<Block>& wires) { batches.push_back(wires); });
+  while (!isAccepted || !transport.isConnected()) {
+    io.run_one();
+  }
+
+  // three packets and the first half of a fourth in a single write
+  Block packets[] = {makeNonNegativeIntegerBlock(tlv::Content, 1),
+                     makeNonNegativeIntegerBlock(tlv::Content, 2),
+                     makeNonNegativeIntegerBlock(tlv::Content, 3),
+                     makeNonNegativeIntegerBlock(tlv::Content, 0x04040404)};
+  std::vector<uint8_t> bytes;
+  for (const Block& packet : packets) {
+    bytes.insert(bytes.end(), packet.begin(), packet.end());
+  }
+  boost::asio::write(forwarder, boost::asio::buffer(bytes.data(), bytes.size() - 3));
+  while (batches.empty()) {
+    io.run_one();
+  }
+
+  BOOST_REQUIRE_EQUAL(batches.size(), 1);
+  BOOST_REQUIRE_EQUAL(batches[0].size(), 3);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(batches[0][0]), 1);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(batches[0][2]), 3);
+
+  boost::asio::write(forwarder, boost::asio::buffer(bytes.data() + bytes.size() - 3, 3));
+  while (batches.size() < 2) {
+    io.run_one();
+  }
+  BOOST_REQUIRE_EQUAL(batches[1].size(), 1);
+  BOOST_CHECK_EQUAL(readNonNegativeInteger(batches[1][0]), 0x04040404);
+
+  transport.close();
+  boost::filesystem::remove(socketPath);
+}
+
+BOOST_AUTO_TEST_CASE(BusyPoll)
+{
+  const std::string socketPath = (boost::filesystem::temp_directory_path() /
+                                  boost::filesystem::unique_path()).string();
+
+  boost::asio::io_service io;
+  boost::asio::local::stream_protocol::acceptor acceptor(io, socketPath);
+  boost::asio::local::stream_protocol::socket forwarder(io);
+  bool isAccepted = false;
+  acceptor.async_accept(forwarder, [&] (const boost::system::error_code& error) {
+    BOOST_REQUIRE(!error);
+    isAccepted = true;
+  });
+
+  std::vector<uint64_t> received;
+  UnixTransport transport(socketPath);
+  transport.setBusyPoll(time::milliseconds(1));
+  transport.connect(io, Transport::ReceiveCallback([&] (const Block& wire) {
+    received.push_back(readNonNegativeInteger(wire));
+  }));
+  while (!isAccepted || !transport.isConnected()) {
+    io.run_one();
+  }
+
+  auto sendPackets = [&] (uint64_t first, uint64_t last) {
+    for (uint64_t i = first; i <= last; ++i) {
+      Block packet = makeNonNegativeIntegerBlock(tlv::Content, i);
+      boost::asio::write(forwarder, boost::asio::buffer(packet.wire(), packet.size()));
+    }
+  };
+
+  // the first packets arrive through the reactor, the following ones while polling
+  sendPackets(1, 1);
+  while (received.size() < 1) {
+    io.run_one();
+  }
+  sendPackets(2, 100);
+  while (received.size() < 100) {
+    io.run_one();
+  }
+
+  // after the budget runs out without data, the transport waits in the reactor again
+  auto deadline = boost::chrono::steady_clock::now() + boost::chrono::milliseconds(5);
+  while (boost::chrono::steady_clock::now() < deadline) {
+    io.poll();
+  }
+  sendPackets(101, 110);
+  while (received.size() < 110) {
+    io.run_one();
+  }
+
+  for (uint64_t i = 0; i < received.size(); ++i) {
+    BOOST_REQUIRE_EQUAL(received[i], i + 1);
+  }
+
+  transport.close();
+  boost::filesystem::remove(socketPath);
+}
+
+BOOST_AUTO_TEST_CASE(PauseDuringBusyPoll)
+{
+  const std::string socketPath = (boost::filesystem::temp_directory_path() /
+                                  boost::filesystem::unique_path()).string();
+
+  boost::asio::io_service io;
+  boost::asio::local::stream_protocol::acceptor acceptor(io, socketPath);
+  boost::asio::local::stream_protocol::socket forwarder(io);
+  bool isAccepted = false;
+  acceptor.async_accept(forwarder, [&] (const boost::system::error_code& error) {
+    BOOST_REQUIRE(!error);
+    isAccepted = true;
+  });
+
+  auto sendPackets = [&] (uint64_t first, uint64_t last) {
+    for (uint64_t i = first; i <= last; ++i) {
+      Block packet = makeNonNegativeIntegerBlock(tlv::Content, i);
+      boost::asio::write(forwarder, boost::asio::buffer(packet.wire(), packet.size()));
+    }
+  };
+
+  std::vector<uint64_t> received;
+  UnixTransport transport(socketPath);
+  transport.setBusyPoll(time::seconds(1));
+  transport.connect(io, Transport::ReceiveCallback([&] (const Block& wire) {
+    received.push_back(readNonNegativeInteger(wire));
+    if (received.back() == 65) {
+      // The batch of packets 2-65 has grown the batch size beyond one packet, so the next
+      // poll decodes packet 66 without delivering it.  pause() runs right after that poll.
+      sendPackets(66, 66);
+      io.post([&] { io.post([&] { transport.pause(); }); });
+    }
+  }));
+  while (!isAccepted || !transport.isConnected()) {
+    io.run_one();
+  }
+
+  // the first packet arrives through the reactor and starts polling
+  sendPackets(1, 1);
+  while (received.size() < 1) {
+    io.run_one();
+  }
+  sendPackets(2, 65);
+  while (transport.isExpectingData()) {
+    io.run_one();
+  }
+  io.poll();
+  io.reset(); // nothing was pending while paused
+  // the packet decoded before pause() is delivered, not dropped
+  BOOST_CHECK_EQUAL(received.size(), 66);
+
+  transport.resume();
+  sendPackets(67, 67);
+  while (received.back() != 67) {
+    io.run_one();
+  }
+
+  for (uint64_t i = 0; i < received.size(); ++i) {
+    BOOST_REQUIRE_EQUAL(received[i], i + 1);
+  }
+
+  transport.close();
+  boost::filesystem::remove(socketPath);
+}
+
+BOOST_AUTO_TEST_CASE(CloseDuringBusyPoll)
+{
+  const std::string socketPath = (boost::filesystem::temp_directory_path() /
+                                  boost::filesystem::unique_path()).string();
+
+  boost::asio::io_service io;
+  boost::asio::local::stream_protocol::acceptor acceptor(io, socketPath);
+  boost::asio::local::stream_protocol::socket forwarder(io);
+  bool isAccepted = false;
+  auto accept = [&] {
+    isAccepted = false;
+    acceptor.async_accept(forwarder, [&] (const boost::system::error_code& error) {
+      BOOST_REQUIRE(!error);
+      isAccepted = true;
+    });
+  };
+
+  std::vector<uint64_t> received;
+  UnixTransport transport(socketPath);
+  transport.setBusyPoll(time::seconds(1));
+  Transport::ReceiveCallback receive([&] (const Block& wire) {
+    received.push_back(readNonNegativeInteger(wire));
+  });
+
+  accept();
+  transport.connect(io, receive);
+  while (!isAccepted || !transport.isConnected()) {
+    io.run_one();
+  }
+
+  // the first packet arrives through the reactor and starts polling
+  Block packet = makeNonNegativeIntegerBlock(tlv::Content, 1);
+  boost::asio::write(forwarder, boost::asio::buffer(packet.wire(), packet.size()));
+  while (received.size() < 1) {
+    io.run_one();
+  }
+
+  // polling stops with the old connection and starts again on the new one
+  transport.close();
+  forwarder.close();
+  accept();
+  transport.connect(io, receive);
+  while (!isAccepted || !transport.isConnected()) {
+    io.run_one();
+  }
+
+  packet = makeNonNegativeIntegerBlock(tlv::Content, 2);
+  boost::asio::write(forwarder, boost::asio::buffer(packet.wire(), packet.size()));
+  while (received.size() < 2) {
+    io.run_one();
+  }
+  BOOST_CHECK_EQUAL(received.back(), 2);
+
+  transport.close();
+  boost::filesystem::remove(socketPath);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace tests
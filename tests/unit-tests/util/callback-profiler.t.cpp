@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/callback-profiler.hpp"
+
+#include "boost-test.hpp"
+
+#include <sstream>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+class CallbackProfilerFixture
+{
+public:
+  CallbackProfilerFixture()
+    : profiler(CallbackProfiler::getInstance())
+  {
+    profiler.reset();
+  }
+
+  ~CallbackProfilerFixture()
+  {
+    profiler.reset();
+    profiler.disableTrace();
+    profiler.setPrefixLength(2);
+    profiler.setNSlowestCalls(5);
+  }
+
+  void
+  record(CallbackProfiler::CallbackType type, const Name& name, int64_t wallDuration,
+         const Name& prefix = Name())
+  {
+    profiler.record(type, name, prefix, time::steady_clock::TimePoint(time::milliseconds(1)),
+                    time::nanoseconds(wallDuration));
+  }
+
+public:
+  CallbackProfiler& profiler;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilCallbackProfiler, CallbackProfilerFixture)
+
+BOOST_AUTO_TEST_CASE(Aggregate)
+{
+  profiler.setNSlowestCalls(2);
+  record(CallbackProfiler::ON_DATA, "/A/B/1", 300);
+  record(CallbackProfiler::ON_DATA, "/A/B/2", 100);
+  record(CallbackProfiler::ON_DATA, "/A/B/3", 200);
+  record(CallbackProfiler::ON_TIMEOUT, "/A/B/4", 50);
+  record(CallbackProfiler::ON_INTEREST, "/P/x/y", 10, "/P");
+
+  const CallbackProfiler::Profile& profile = profiler.getProfile();
+  BOOST_REQUIRE_EQUAL(profile.size(), 3);
+
+  const CallbackProfiler::Entry& onData = profile.at({CallbackProfiler::ON_DATA, "/A/B"});
+  BOOST_CHECK_EQUAL(onData.nCalls, 3);
+  BOOST_CHECK_EQUAL(onData.totalWallDuration, time::nanoseconds(600));
+  BOOST_CHECK_EQUAL(onData.maxWallDuration, time::nanoseconds(300));
+  BOOST_REQUIRE_EQUAL(onData.slowestCalls.size(), 2);
+  BOOST_CHECK_EQUAL(onData.slowestCalls[0].name, Name("/A/B/1"));
+  BOOST_CHECK_EQUAL(onData.slowestCalls[1].name, Name("/A/B/3"));
+
+  BOOST_CHECK_EQUAL(profile.count({CallbackProfiler::ON_TIMEOUT, "/A/B"}), 1);
+  BOOST_CHECK_EQUAL(profile.count({CallbackProfiler::ON_INTEREST, "/P"}), 1);
+
+  std::ostringstream os;
+  profiler.printFlatProfile(os);
+  BOOST_CHECK_EQUAL(os.str().find("OnData /A/B calls=3 total=600 mean=200 max=300"), 0);
+
+  profiler.reset();
+  BOOST_CHECK(profiler.getProfile().empty());
+}
+
+BOOST_AUTO_TEST_CASE(ChromeTrace)
+{
+  record(CallbackProfiler::ON_DATA, "/A/1", 300);
+
+  profiler.enableTrace(2);
+  record(CallbackProfiler::ON_DATA, "/A/2", 2000);
+  record(CallbackProfiler::ON_INTEREST, "/A/3", 1000, "/A");
+  record(CallbackProfiler::ON_INTEREST, "/A/4", 1000, "/A");
+
+  std::ostringstream os;
+  profiler.writeChromeTrace(os);
+  std::string trace = os.str();
+  BOOST_CHECK_EQUAL(trace.find("/A/1"), std::string::npos);
+  BOOST_CHECK(trace.find("{\"name\":\"/A/2\",\"cat\":\"OnData\",\"ph\":\"X\",\"ts\":1000,\"dur\":2,")
+              != std::string::npos);
+  BOOST_CHECK(trace.find("\"/A/3\"") != std::string::npos);
+  BOOST_CHECK_EQUAL(trace.find("/A/4"), std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2015 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/dummy-client-face.hpp"
+
+#include "boost-test.hpp"
+#include "../unit-test-time-fixture.hpp"
+#include "../make-interest-data.hpp"
+
+#include <sstream>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+class DummyClientFaceReplayFixture : public ndn::tests::UnitTestTimeFixture
+{
+public:
+  DummyClientFaceReplayFixture()
+    : face(makeDummyClientFace(io, {false, false}))
+  {
+  }
+
+public:
+  shared_ptr<DummyClientFace> face;
+};
+
+BOOST_FIXTURE_TEST_SUITE(UtilDummyClientFace, DummyClientFaceReplayFixture)
+
+BOOST_AUTO_TEST_CASE(LoadTrace)
+{
+  Block interest = Interest("/A").wireEncode();
+  Block data = makeData("/A/1")->wireEncode();
+
+  std::stringstream trace;
+  trace.write(reinterpret_cast<const char*>(interest.wire()), interest.size());
+  trace.write(reinterpret_cast<const char*>(data.wire()), data.size());
+
+  std::vector<Block> blocks = DummyClientFace::loadTrace(trace);
+  BOOST_REQUIRE_EQUAL(blocks.size(), 2);
+  BOOST_CHECK(blocks[0] == interest);
+  BOOST_CHECK(blocks[1] == data);
+
+  std::stringstream truncated;
+  truncated.write(reinterpret_cast<const char*>(interest.wire()), interest.size() - 1);
+  BOOST_CHECK_THROW(DummyClientFace::loadTrace(truncated), tlv::Error);
+
+  Block name = Name("/A").wireEncode();
+  std::stringstream wrongType;
+  wrongType.write(reinterpret_cast<const char*>(name.wire()), name.size());
+  BOOST_CHECK_THROW(DummyClientFace::loadTrace(wrongType), tlv::Error);
+
+  Block nameless(tlv::Interest);
+  nameless.push_back(makeBinaryBlock(tlv::Nonce, "\x01\x02\x03\x04", 4));
+  nameless.encode();
+  std::stringstream invalidInterest;
+  invalidInterest.write(reinterpret_cast<const char*>(nameless.wire()), nameless.size());
+  BOOST_CHECK_THROW(DummyClientFace::loadTrace(invalidInterest), tlv::Error);
+
+  BOOST_CHECK_THROW(face->startReplay({interest, nameless}, 1000), tlv::Error);
+  BOOST_CHECK(!face->isReplaying());
+}
+
+BOOST_AUTO_TEST_CASE(Replay)
+{
+  face->setInterestFilter(Name("/A"), [this] (const InterestFilter&, const Interest& interest) {
+      face->put(*makeData(Name(interest.getName()).append("segment")));
+    });
+  advanceClocks(time::milliseconds(1));
+
+  std::vector<Block> trace;
+  for (int i = 0; i < 10; ++i) {
+    trace.push_back(Interest(Name("/A").appendNumber(i)).wireEncode());
+  }
+  trace.push_back(makeData("/B")->wireEncode());
+
+  int nReplayEnds = 0;
+  face->onReplayEnd.connect([&] (const DummyClientFace::ReplayStatistics& statistics) {
+      ++nReplayEnds;
+      BOOST_CHECK_EQUAL(statistics.nInjectedInterests, 10);
+      BOOST_CHECK_EQUAL(statistics.nInjectedData, 1);
+    });
+
+  face->startReplay(trace, 1000, 4);
+  BOOST_CHECK(face->isReplaying());
+  advanceClocks(time::milliseconds(1), 20);
+  BOOST_CHECK(!face->isReplaying());
+  BOOST_CHECK_EQUAL(nReplayEnds, 1);
+
+  const DummyClientFace::ReplayStatistics& statistics = face->getReplayStatistics();
+  BOOST_CHECK_EQUAL(statistics.nSentData, 10);
+  BOOST_CHECK_EQUAL(statistics.nSentInterests, 0);
+  BOOST_CHECK(statistics.duration == time::milliseconds(10));
+  BOOST_CHECK_CLOSE(statistics.getThroughput(), 1100, 0.1);
+  BOOST_CHECK_EQUAL(statistics.responseLatency.getCount(), 10);
+
+  // only the most recent Data are captured
+  BOOST_REQUIRE_EQUAL(face->replayCapturedDatas.size(), 4);
+  BOOST_CHECK_EQUAL(face->replayCapturedDatas.back().getName(),
+                    Name("/A").appendNumber(9).append("segment"));
+}
+
+BOOST_AUTO_TEST_CASE(ReplayInterestExpiry)
+{
+  std::vector<Block> trace;
+  trace.push_back(Interest("/A", time::milliseconds(10)).wireEncode());
+  trace.push_back(Interest("/B", time::milliseconds(100)).wireEncode());
+
+  face->startReplay(trace, 0);
+  advanceClocks(time::milliseconds(1), 20);
+
+  // the Interest for /A has expired, so its late Data is not a response
+  face->put(*makeData("/A/segment"));
+  face->put(*makeData("/B/segment"));
+  advanceClocks(time::milliseconds(1));
+
+  const DummyClientFace::ReplayStatistics& statistics = face->getReplayStatistics();
+  BOOST_CHECK_EQUAL(statistics.nSentData, 2);
+  BOOST_CHECK_EQUAL(statistics.responseLatency.getCount(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(StopReplay)
+{
+  std::vector<Block> trace(100, Interest("/A").wireEncode());
+
+  face->startReplay(trace, 1000);
+  advanceClocks(time::milliseconds(1), 5);
+  face->stopReplay();
+  BOOST_CHECK(!face->isReplaying());
+  uint64_t nInjected = face->getReplayStatistics().nInjectedInterests;
+  BOOST_CHECK_GT(nInjected, 0);
+
+  advanceClocks(time::milliseconds(1), 5);
+  BOOST_CHECK_EQUAL(face->getReplayStatistics().nInjectedInterests, nInjected);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -25,6 +25,9 @@
 #include "boost-test.hpp"
 #include "../unit-test-time-fixture.hpp"
 
+#include <set>
+#include <unordered_set>
+
 namespace ndn {
 namespace util {
 namespace scheduler {
@@ -85,6 +88,65 @@ BOOST_AUTO_TEST_CASE(SelfCancel)
   BOOST_REQUIRE_NO_THROW(advanceClocks(time::milliseconds(100), 10));
 }
 
+BOOST_AUTO_TEST_CASE(ReleaseCallback)
+{
+  Scheduler scheduler(io);
+  auto resource = make_shared<int>(1);
+
+  EventId fired = scheduler.scheduleEvent(time::milliseconds(10), [resource] {});
+  EventId cancelled = scheduler.scheduleEvent(time::milliseconds(10), [resource] {});
+  BOOST_CHECK_EQUAL(resource.use_count(), 3);
+
+  EventId copy = cancelled;
+  scheduler.cancelEvent(copy);
+  BOOST_CHECK(copy == nullptr);
+  BOOST_CHECK(cancelled != nullptr);
+  BOOST_CHECK_EQUAL(resource.use_count(), 2);
+
+  advanceClocks(time::milliseconds(1), 15);
+  BOOST_CHECK(fired != nullptr);
+  BOOST_CHECK_EQUAL(resource.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(EventIdCompatibility)
+{
+  // usages of the former shared_ptr<ns3::EventId>
+  Scheduler scheduler(io);
+
+  EventId fired = scheduler.scheduleEvent(time::milliseconds(10), [] {});
+  EventId cancelled = scheduler.scheduleEvent(time::milliseconds(10), [] {});
+  EventId copy = cancelled;
+  BOOST_CHECK(static_cast<bool>(fired));
+  BOOST_CHECK(fired->IsRunning());
+  BOOST_CHECK(!(*cancelled).IsExpired());
+  BOOST_CHECK(nullptr != fired);
+
+  std::set<EventId> ordered{fired, cancelled};
+  std::unordered_set<EventId> unordered{fired, cancelled, copy};
+  BOOST_CHECK_EQUAL(ordered.size(), 2);
+  BOOST_CHECK_EQUAL(unordered.size(), 2);
+  BOOST_CHECK_EQUAL(unordered.count(copy), 1);
+
+  scheduler.cancelEvent(cancelled);
+  BOOST_CHECK(!static_cast<bool>(cancelled));
+  BOOST_CHECK(copy->IsExpired());
+
+  advanceClocks(time::milliseconds(1), 15);
+  BOOST_CHECK(!fired->IsRunning());
+}
+
+BOOST_AUTO_TEST_CASE(DestructionCancelsEvents)
+{
+  bool isFired = false;
+  {
+    Scheduler scheduler(io);
+    scheduler.scheduleEvent(time::milliseconds(10), [&] { isFired = true; });
+  }
+
+  advanceClocks(time::milliseconds(1), 15);
+  BOOST_CHECK_EQUAL(isFired, false);
+}
+
 class SelfRescheduleFixture : public UnitTestTimeFixture
 {
 public:
@@ -73,17 +73,21 @@ Consumer::run()
 {
   try
     {
+      // the initial window is expressed as one batch
+      std::vector<Interest> window;
+      window.reserve(m_pipeSize);
       for (size_t i = 0; i < m_pipeSize; i++)
         {
           Interest interest(Name(m_dataName).appendSegment(m_nextSegment++));
           interest.setInterestLifetime(time::milliseconds(4000));
           interest.setMustBeFresh(m_mustBeFresh);
-
-          m_face.expressInterest(interest,
-                                 bind(&Consumer::onData, this, _2),
-                                 bind(&Consumer::onTimeout, this, _1));
+          window.push_back(interest);
         }
 
+      m_face.expressInterests(window,
+                              bind(&Consumer::onData, this, _2),
+                              bind(&Consumer::onTimeout, this, _1));
+
       // processEvents will block until the requested data received or timeout occurs
       m_face.processEvents();
     }